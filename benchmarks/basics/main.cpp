@@ -1,10 +1,15 @@
+#include <iomanip>
 #include <random>
+#include <sstream>
+#include <string>
 #include <vector>
 //
 #include <perfevent/perfevent.hpp>
 //
 // #include <lyrahgames/delaunay/delaunay.hpp>
 #include <lyrahgames/delaunay/bowyer_watson.hpp>
+#include <lyrahgames/delaunay/memory.hpp>
+#include <lyrahgames/delaunay/statistics.hpp>
 
 using namespace std;
 using namespace lyrahgames;
@@ -12,9 +17,36 @@ using delaunay::bowyer_watson::point;
 using delaunay::bowyer_watson::triangle;
 
 struct benchmark {
+  static string fixed(double x) {
+    stringstream stream{};
+    stream << setprecision(2) << std::fixed << x;
+    return stream.str();
+  }
+
+  // The statistics and the memory usage are collected by an additional
+  // untimed run such that the timed run is not influenced
+  // by the instrumentation.
+  void set_statistics(const delaunay::statistics& s) {
+    const auto n = static_cast<double>(max<size_t>(s.insertions, 1));
+    params.setParam("incircle/pt", fixed(s.incircle_tests / n));
+    params.setParam("cavity", fixed(s.removed_elements.mean()));
+    params.setParam("max cavity", s.removed_elements.max);
+    params.setParam("created", fixed(s.created_elements.mean()));
+
+    const auto& m = delaunay::memory_usage();
+    params.setParam("peak KiB", fixed(m.peak_bytes / 1024.0));
+    params.setParam("peak B/pt", fixed(m.peak_bytes / n));
+    params.setParam("allocs", m.allocations);
+  }
+
   benchmark& run(size_t n) noexcept {
     points.resize(n);
     for (auto& p : points) p = point{dist(rng), dist(rng)};
+    delaunay::statistics statistics{};
+    delaunay::memory_usage() = {};
+    delaunay::bowyer_watson::triangulation<delaunay::tracking_allocator>(
+        points, nullptr, statistics);
+    set_statistics(statistics);
     triangles.clear();
     {
       params.setParam("          name", "default");
@@ -29,6 +61,11 @@ struct benchmark {
   benchmark& run_experimental(size_t n) noexcept {
     points.resize(n);
     for (auto& p : points) p = point{dist(rng), dist(rng)};
+    delaunay::statistics statistics{};
+    delaunay::memory_usage() = {};
+    delaunay::bowyer_watson::experimental::triangulation<
+        delaunay::tracking_allocator>(points, nullptr, nullptr, statistics);
+    set_statistics(statistics);
     triangles.clear();
     {
       params.setParam("          name", "experimental");
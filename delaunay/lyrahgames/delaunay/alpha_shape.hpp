@@ -0,0 +1,413 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+//
+#include <lyrahgames/delaunay/bowyer_watson.hpp>
+#include <lyrahgames/delaunay/compact_mesh.hpp>
+#include <lyrahgames/delaunay/connectivity.hpp>
+#include <lyrahgames/delaunay/radix_sort.hpp>
+
+namespace lyrahgames::delaunay {
+
+// Alpha values are squared radii such that they can directly be compared
+// to the cached circumspheres. A simplex is part of the alpha complex
+// for a given alpha if its alpha value is smaller or equal.
+// The alpha value of a simplex is the squared radius of its smallest
+// circumsphere if this sphere contains no other vertex of its cofaces.
+// Otherwise, the simplex is attached and enters the complex
+// together with its first coface.
+// Besides 'alpha', faces and edges store the interval [mid, max) for which
+// they are on the boundary of the alpha shape. Up to 'mid', no coface is
+// part of the complex and the simplex is singular. Starting with 'max',
+// all cofaces are part of the complex and the simplex is interior.
+
+constexpr float alpha_infinity = std::numeric_limits<float>::infinity();
+
+// Simplices are sorted by their alpha values. The simplices of
+// an alpha complex are a prefix which is found by a binary search.
+template <typename Simplex>
+auto alpha_prefix(const std::vector<Simplex>& simplices, float alpha) {
+  const auto last = std::upper_bound(
+      simplices.begin(), simplices.end(), alpha,
+      [](float x, const Simplex& s) { return x < s.alpha; });
+  return std::span<const Simplex>{simplices.data(),
+                                  size_t(last - simplices.begin())};
+}
+
+// Returns the permutation sorting the given non-negative alpha values.
+// The bit patterns of non-negative floats are ordered like their values.
+inline auto alpha_order(const std::vector<float>& alpha) {
+  std::vector<uint64_t> keys(alpha.size());
+  std::vector<size_t> order(alpha.size());
+  for (size_t i = 0; i < alpha.size(); ++i) {
+    keys[i] = std::bit_cast<uint32_t>(alpha[i]);
+    order[i] = i;
+  }
+  radix_sort(keys, order);
+  return order;
+}
+
+template <typename Simplex>
+void sort_by_alpha(std::vector<Simplex>& simplices) {
+  std::vector<float> alpha(simplices.size());
+  for (size_t i = 0; i < simplices.size(); ++i) alpha[i] = simplices[i].alpha;
+  const auto order = alpha_order(alpha);
+  std::vector<Simplex> sorted(simplices.size());
+  for (size_t i = 0; i < order.size(); ++i) sorted[i] = simplices[order[i]];
+  simplices.swap(sorted);
+}
+
+// Entry of the filtration which orders all simplices by their alpha values.
+// Faces of a simplex with equal alpha value come first.
+struct filtration_entry {
+  float alpha;
+  uint32_t dimension;
+  // Index of a vertex or of a simplex in its sorted list.
+  uint32_t index;
+};
+
+namespace experimental_3d {
+
+struct alpha_complex {
+  struct tetrahedron {
+    // Index of the tetrahedron in the mesh.
+    uint32_t index;
+    float alpha;
+  };
+  // Faces are oriented such that the coface entering the complex first
+  // lies on their negative side. Hence, regular boundary faces
+  // are oriented counterclockwise when seen from the outside.
+  struct face {
+    std::array<uint32_t, 3> vertices;
+    float alpha, mid, max;
+  };
+  struct edge {
+    std::array<uint32_t, 2> vertices;
+    float alpha, mid, max;
+  };
+
+  auto tetrahedra_until(float alpha) const {
+    return alpha_prefix(tetrahedra, alpha);
+  }
+  auto faces_until(float alpha) const { return alpha_prefix(faces, alpha); }
+  auto edges_until(float alpha) const { return alpha_prefix(edges, alpha); }
+
+  // Regular and singular faces form the boundary of the alpha shape.
+  auto boundary(float alpha) const {
+    std::vector<face> result{};
+    for (const auto& f : faces_until(alpha))
+      if (alpha < f.max) result.push_back(f);
+    return result;
+  }
+
+  // Vertices, edges, faces, and tetrahedra ordered by their alpha values.
+  auto filtration() const {
+    std::vector<filtration_entry> result{};
+    result.reserve(vertices.size() + edges.size() + faces.size() +
+                   tetrahedra.size());
+    for (const auto v : vertices) result.push_back({0, 0, v});
+    for (uint32_t i = 0; i < edges.size(); ++i)
+      result.push_back({edges[i].alpha, 1, i});
+    for (uint32_t i = 0; i < faces.size(); ++i)
+      result.push_back({faces[i].alpha, 2, i});
+    for (uint32_t i = 0; i < tetrahedra.size(); ++i)
+      result.push_back({tetrahedra[i].alpha, 3, i});
+    std::stable_sort(result.begin(), result.end(),
+                     [](const auto& x, const auto& y) {
+                       return (x.alpha < y.alpha) ||
+                              ((x.alpha == y.alpha) &&
+                               (x.dimension < y.dimension));
+                     });
+    return result;
+  }
+
+  // Vertices of the mesh. Their alpha value is zero.
+  std::vector<uint32_t> vertices{};
+  std::vector<tetrahedron> tetrahedra{};
+  std::vector<face> faces{};
+  std::vector<edge> edges{};
+};
+
+namespace detail {
+
+// Squared radius and center of the smallest circumsphere of a triangle
+// given relative to its first vertex.
+constexpr auto circumcircle(const point& a, const point& b,
+                            const point& c) noexcept {
+  const auto u = b - a;
+  const auto v = c - a;
+  const auto w = cross(u, v);
+  const auto m = (1.0f / (2.0f * sqnorm(w))) *
+                 (sqnorm(u) * cross(v, w) + sqnorm(v) * cross(w, u));
+  return sphere{m, sqnorm(m)};
+}
+
+}  // namespace detail
+
+// Computes the alpha values of all simplices of a compacted mesh.
+// The cached circumspheres are reused as the alpha values of the tetrahedra.
+// Every face is visited once by the tetrahedron with the smaller index and
+// the faces around each edge are grouped by a radix sort of the edge keys.
+template <bool Cache, template <typename> typename Allocator>
+auto make_alpha_complex(const compact::mesh<Cache, Allocator>& mesh) {
+  using namespace compact;
+  const auto& points = mesh.points();
+  const auto& elements = mesh.tetrahedra();
+  alpha_complex result{};
+
+  std::vector<float> tetrahedron_alpha(elements.size());
+  for (uint32_t t = 0; t < elements.size(); ++t) {
+    if constexpr (Cache) {
+      tetrahedron_alpha[t] = mesh.spheres()[t].r2;
+    } else {
+      const auto [a, b, c, d] = elements[t].vertices;
+      tetrahedron_alpha[t] =
+          circumsphere(points[a], points[b], points[c], points[d]).r2;
+    }
+  }
+  result.tetrahedra.reserve(elements.size());
+  for (const auto t : alpha_order(tetrahedron_alpha))
+    result.tetrahedra.push_back({uint32_t(t), tetrahedron_alpha[t]});
+
+  std::vector<bool> used(points.size(), false);
+  for (const auto& t : elements)
+    for (const auto v : t.vertices) used[v] = true;
+  for (uint32_t v = 0; v < points.size(); ++v)
+    if (used[v]) result.vertices.push_back(v);
+
+  // Edges are collected together with their faces for the Gabriel test.
+  auto& faces = result.faces;
+  std::vector<uint64_t> edge_keys{};
+  std::vector<size_t> edge_faces{};
+  for (uint32_t t = 0; t < elements.size(); ++t) {
+    const auto& [v, n] = elements[t];
+    for (uint32_t f = 0; f < 4; ++f) {
+      const auto neighbor = tetrahedron_of(n[f]);
+      if ((n[f] != no_neighbor) && (neighbor < t)) continue;
+      const auto& fv = face_vertices[f];
+      std::array<uint32_t, 3> vertices{v[fv[0]], v[fv[1]], v[fv[2]]};
+      const auto& a = points[vertices[0]];
+      const auto s =
+          detail::circumcircle(a, points[vertices[1]], points[vertices[2]]);
+      const auto encroached = [&](uint32_t u) {
+        return sqnorm(points[u] - a - s.c) < s.r2;
+      };
+
+      const auto x = tetrahedron_alpha[t];
+      auto y = alpha_infinity;
+      bool attached = encroached(v[f]);
+      if (n[f] != no_neighbor) {
+        y = tetrahedron_alpha[neighbor];
+        attached |= encroached(elements[neighbor].vertices[face_of(n[f])]);
+      }
+      // The tetrahedron lies on the positive side of its face.
+      if (x <= y) std::swap(vertices[1], vertices[2]);
+      const auto mid = std::min(x, y);
+      // Rounding errors must not let a face enter after its cofaces.
+      const auto alpha = attached ? mid : std::min(s.r2, mid);
+      faces.push_back({vertices, alpha, mid, std::max(x, y)});
+
+      for (uint32_t i = 0; i < 3; ++i) {
+        const auto p = vertices[i];
+        const auto q = vertices[(i + 1) % 3];
+        edge_keys.push_back((uint64_t{std::min(p, q)} << 32) |
+                            std::max(p, q));
+        edge_faces.push_back(faces.size() - 1);
+      }
+    }
+  }
+
+  radix_sort(edge_keys, edge_faces);
+  for (size_t i = 0; i < edge_keys.size();) {
+    const auto key = edge_keys[i];
+    const uint32_t p = key >> 32;
+    const uint32_t q = key & 0xffffffff;
+    const auto& a = points[p];
+    const auto& b = points[q];
+    alpha_complex::edge e{{p, q}, 0, alpha_infinity, 0};
+    bool attached = false;
+    for (; (i < edge_keys.size()) && (edge_keys[i] == key); ++i) {
+      const auto& f = faces[edge_faces[i]];
+      const auto u = f.vertices[0] ^ f.vertices[1] ^ f.vertices[2] ^ p ^ q;
+      // Points inside the diametral sphere see the edge at an obtuse angle.
+      attached |= dot(a - points[u], b - points[u]) < 0;
+      e.mid = std::min(e.mid, f.alpha);
+      e.max = std::max(e.max, f.max);
+    }
+    e.alpha = attached ? e.mid : std::min(0.25f * sqnorm(b - a), e.mid);
+    result.edges.push_back(e);
+  }
+
+  sort_by_alpha(result.faces);
+  sort_by_alpha(result.edges);
+  return result;
+}
+
+}  // namespace experimental_3d
+
+namespace bowyer_watson {
+
+struct alpha_complex {
+  struct triangle {
+    std::array<size_t, 3> vertices;
+    float alpha;
+  };
+  // Edges are oriented such that the coface entering the complex first
+  // lies on their left side. Hence, regular boundary edges are
+  // oriented counterclockwise around the alpha shape.
+  struct edge {
+    std::array<size_t, 2> vertices;
+    float alpha, mid, max;
+  };
+
+  auto triangles_until(float alpha) const {
+    return alpha_prefix(triangles, alpha);
+  }
+  auto edges_until(float alpha) const { return alpha_prefix(edges, alpha); }
+
+  // Regular and singular edges form the boundary of the alpha shape.
+  auto boundary(float alpha) const {
+    std::vector<edge> result{};
+    for (const auto& e : edges_until(alpha))
+      if (alpha < e.max) result.push_back(e);
+    return result;
+  }
+
+  // Chains the regular boundary edges into closed polygons.
+  // Outer boundaries are counterclockwise and holes are clockwise.
+  // At vertices where the shape touches itself,
+  // the next edge is chosen arbitrarily.
+  auto polygons(float alpha) const {
+    std::vector<std::array<size_t, 2>> regular{};
+    for (const auto& e : edges_until(alpha))
+      if ((e.mid <= alpha) && (alpha < e.max)) regular.push_back(e.vertices);
+    std::sort(regular.begin(), regular.end());
+
+    std::vector<bool> visited(regular.size(), false);
+    std::vector<std::vector<size_t>> result{};
+    for (size_t i = 0; i < regular.size(); ++i) {
+      if (visited[i]) continue;
+      auto& polygon = result.emplace_back();
+      for (auto j = i; !visited[j];) {
+        visited[j] = true;
+        polygon.push_back(regular[j][0]);
+        const auto v = regular[j][1];
+        auto it = std::lower_bound(regular.begin(), regular.end(),
+                                   std::array<size_t, 2>{v, 0});
+        while ((it != regular.end()) && ((*it)[0] == v) &&
+               visited[it - regular.begin()])
+          ++it;
+        if ((it == regular.end()) || ((*it)[0] != v)) break;
+        j = it - regular.begin();
+      }
+    }
+    return result;
+  }
+
+  // Vertices, edges, and triangles ordered by their alpha values.
+  auto filtration() const {
+    std::vector<filtration_entry> result{};
+    result.reserve(vertices.size() + edges.size() + triangles.size());
+    for (const auto v : vertices) result.push_back({0, 0, uint32_t(v)});
+    for (uint32_t i = 0; i < edges.size(); ++i)
+      result.push_back({edges[i].alpha, 1, i});
+    for (uint32_t i = 0; i < triangles.size(); ++i)
+      result.push_back({triangles[i].alpha, 2, i});
+    std::stable_sort(result.begin(), result.end(),
+                     [](const auto& x, const auto& y) {
+                       return (x.alpha < y.alpha) ||
+                              ((x.alpha == y.alpha) &&
+                               (x.dimension < y.dimension));
+                     });
+    return result;
+  }
+
+  // Vertices of the triangulation. Their alpha value is zero.
+  std::vector<size_t> vertices{};
+  std::vector<triangle> triangles{};
+  std::vector<edge> edges{};
+};
+
+// Computes the alpha values of all simplices of a triangulation
+// from the squared circumradii of its triangles. The edges are visited
+// once by the triangle with the smaller index.
+template <typename Triangles, typename Radii>
+auto make_alpha_complex(const std::vector<point>& points,
+                        const Triangles& triangles,
+                        const connectivity<3>& adjacency,
+                        const Radii& squared_radii) {
+  alpha_complex result{};
+
+  std::vector<float> triangle_alpha(squared_radii.begin(),
+                                    squared_radii.end());
+  result.triangles.reserve(triangles.size());
+  for (const auto t : alpha_order(triangle_alpha))
+    result.triangles.push_back(
+        {{triangles[t][0], triangles[t][1], triangles[t][2]},
+         triangle_alpha[t]});
+
+  for (size_t v = 0; v < points.size(); ++v)
+    if (adjacency.degree(v) > 0) result.vertices.push_back(v);
+
+  for (size_t t = 0; t < triangles.size(); ++t) {
+    for (size_t k = 0; k < 3; ++k) {
+      const auto neighbor = adjacency.neighbors[t][k];
+      if ((neighbor != adjacency.none) && (neighbor < t)) continue;
+      auto p = triangles[t][(k + 1) % 3];
+      auto q = triangles[t][(k + 2) % 3];
+      const auto& a = points[p];
+      const auto& b = points[q];
+      // Points inside the diametral circle see the edge at an obtuse angle.
+      const auto encroached = [&](size_t u) {
+        return dot(a - points[u], b - points[u]) < 0;
+      };
+
+      const auto x = triangle_alpha[t];
+      auto y = alpha_infinity;
+      bool attached = encroached(triangles[t][k]);
+      if (neighbor != adjacency.none) {
+        y = triangle_alpha[neighbor];
+        const auto& n = triangles[neighbor];
+        attached |= encroached(n[0] ^ n[1] ^ n[2] ^ p ^ q);
+      }
+      // Put the triangle entering first on the left side.
+      const auto u = triangles[t][k];
+      const bool left = counterclockwise(a, b, points[u]);
+      if (left != (x <= y)) std::swap(p, q);
+      const auto mid = std::min(x, y);
+      // Rounding errors must not let an edge enter after its cofaces.
+      const auto alpha =
+          attached ? mid : std::min(0.25f * sqnorm(b - a), mid);
+      result.edges.push_back({{p, q}, alpha, mid, std::max(x, y)});
+    }
+  }
+
+  sort_by_alpha(result.edges);
+  return result;
+}
+
+namespace experimental {
+
+// Triangulates the points and reuses the cached circumcircles
+// of the construction for the alpha values of the triangles.
+template <typename Statistics = no_statistics>
+auto alpha_triangulation(std::vector<point>& points,
+                         Statistics&& statistics = {}) {
+  connectivity<3> adjacency{};
+  std::vector<float> squared_radii{};
+  const auto triangles =
+      triangulation(points, &adjacency, &squared_radii, statistics);
+  return make_alpha_complex(points, triangles, adjacency, squared_radii);
+}
+
+}  // namespace experimental
+
+}  // namespace bowyer_watson
+
+}  // namespace lyrahgames::delaunay
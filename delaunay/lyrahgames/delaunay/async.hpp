@@ -0,0 +1,153 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+//
+#include <lyrahgames/delaunay/guibas_stolfi.hpp>
+
+namespace lyrahgames::delaunay::async {
+
+// Asynchronous triangulation for interactive applications. The points are
+// inserted one by one into the quad-edge engine in time slices. Every slice
+// is a task posted to a caller-supplied executor, which is any callable
+// taking a 'std::function<void()>'. A slice inserts points until its time
+// budget is used up and then posts the next slice. So a thread pool, a
+// detached thread or a queue that is processed once per frame on the render
+// thread can all be used to run the work. The returned handle reports the
+// progress, allows cooperative cancellation and waits for the result.
+
+using point = guibas_stolfi::point;
+using triangle = std::array<size_t, 3>;
+using executor = std::function<void(std::function<void()>)>;
+
+namespace detail {
+
+// State shared by the handle and the posted slices.
+struct state {
+  std::vector<point> points{};
+  guibas_stolfi::edge_algebra diagram{};
+  executor post{};
+  std::chrono::nanoseconds budget{};
+
+  std::atomic<size_t> inserted{0};
+  std::atomic<bool> cancelled{false};
+  std::atomic<bool> finished{false};
+
+  std::mutex mutex{};
+  std::condition_variable condition{};
+  std::vector<triangle> result{};
+  std::exception_ptr error{};
+
+  void finish() {
+    {
+      std::lock_guard lock{mutex};
+      finished = true;
+    }
+    condition.notify_all();
+  }
+};
+
+// The first three points are the super triangle.
+inline void run(const std::shared_ptr<state>& s) {
+  try {
+    const auto n = s->points.size() - 3;
+    const auto start = std::chrono::steady_clock::now();
+    const auto first = s->inserted.load(std::memory_order_relaxed);
+    auto i = first;
+    for (; i < n; ++i) {
+      if (s->cancelled.load(std::memory_order_relaxed)) return s->finish();
+      // Every slice makes progress, even for tiny budgets.
+      if ((s->budget.count() > 0) && (i > first) &&
+          (std::chrono::steady_clock::now() - start >= s->budget))
+        break;
+      s->diagram.add(&s->points[i + 3]);
+      s->inserted.store(i + 1, std::memory_order_relaxed);
+    }
+    if (i < n) return s->post([s] { run(s); });
+    s->result = s->diagram.triangles(s->points.data() + 3, n);
+  } catch (...) {
+    s->error = std::current_exception();
+  }
+  s->finish();
+}
+
+}  // namespace detail
+
+// Future-like handle of an asynchronous triangulation. Copies refer to the
+// same computation. Dropping all handles does not stop it.
+class job {
+ public:
+  job() = default;
+  explicit job(std::shared_ptr<detail::state> s) : s{std::move(s)} {}
+
+  bool valid() const noexcept { return bool(s); }
+
+  // Number of points inserted so far and the total number of points.
+  size_t progress() const noexcept { return s->inserted; }
+  size_t size() const noexcept { return s->points.size() - 3; }
+
+  // Requests cancellation. It takes effect at the next inserted point.
+  void cancel() const noexcept { s->cancelled = true; }
+  bool cancelled() const noexcept { return s->cancelled; }
+
+  // Checks without blocking whether the computation has stopped.
+  bool ready() const noexcept { return s->finished; }
+
+  // Blocks until the computation has stopped. The executor must make
+  // progress on another thread. Otherwise, use 'ready' instead.
+  void wait() const {
+    std::unique_lock lock{s->mutex};
+    s->condition.wait(lock, [this] { return bool(s->finished); });
+  }
+
+  // Waits for and returns the counterclockwise Delaunay triangles.
+  // Throws if the computation has been cancelled or failed.
+  const std::vector<triangle>& get() const {
+    wait();
+    if (s->error) std::rethrow_exception(s->error);
+    if (s->cancelled && (s->inserted < size()))
+      throw std::runtime_error("Asynchronous triangulation was cancelled.");
+    return s->result;
+  }
+
+ private:
+  std::shared_ptr<detail::state> s{};
+};
+
+// Starts the triangulation of the given points by posting its first slice to
+// the executor. A budget of zero computes everything in a single slice.
+// The result is the same as for the other quad-edge based routines and so
+// duplicated points are skipped and very thin triangles at the convex hull
+// may be missing.
+inline job triangulation(std::vector<point> points, executor post,
+                         std::chrono::nanoseconds budget = {}) {
+  if (!post) throw std::invalid_argument("Executor must not be empty.");
+  auto s = std::make_shared<detail::state>();
+  const auto n = points.size();
+  s->points.resize(n + 3);
+  std::copy(points.begin(), points.end(), s->points.begin() + 3);
+  if (n > 0) {
+    const auto super = bounding_triangle(bounding_circle(bounding_box(points)));
+    std::copy(super.begin(), super.end(), s->points.begin());
+  }
+  // Every insertion creates three edges and flips reuse them.
+  // The edges must not be reallocated while points are inserted.
+  s->diagram.edges.reserve(3 * n + 3);
+  s->diagram.set_super_triangle(&s->points[0], &s->points[1], &s->points[2]);
+  s->post = std::move(post);
+  s->budget = budget;
+  s->post([s] { detail::run(s); });
+  return job{std::move(s)};
+}
+
+}  // namespace lyrahgames::delaunay::async
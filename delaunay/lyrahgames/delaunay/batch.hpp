@@ -0,0 +1,196 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+//
+#include <lyrahgames/delaunay/fixed.hpp>
+#include <lyrahgames/delaunay/geometry.hpp>
+#include <lyrahgames/delaunay/parallel.hpp>
+
+namespace lyrahgames::delaunay::batch {
+
+// Triangulation of many independent small point sets in a single call.
+// The sets are given in CSR format by the offsets of their first points.
+// Sets of similar size are grouped and the sets of a group are processed
+// in lockstep by the heap-free engine of 'fixed.hpp'. In every step,
+// each set of the group inserts its next point. Before, the circumcircle
+// tests of all triangles against the new points are evaluated in a single
+// loop over the sets with structure-of-arrays storage, which the compiler
+// vectorizes with one set per SIMD lane. The remaining work of an insertion
+// is done for every set on its own. Groups are distributed over threads.
+
+using point = fixed::point;
+using triangle = fixed::triangle;
+
+// Number of sets in a group. It covers the 8 or 16 floats of typical
+// vector registers.
+constexpr size_t lanes = 16;
+
+// Triangles of all sets in CSR format. The triangles of set s are stored in
+// the range [offsets[s], offsets[s + 1]) and their vertex indices
+// are relative to the first point of the set.
+struct triangle_sets {
+  std::vector<size_t> offsets{};
+  std::vector<triangle> triangles{};
+};
+
+namespace detail {
+
+using row = std::array<float, lanes>;
+
+// Cached circumcircle tests for the triangles of a group of sets.
+// Index [i][l] refers to the i-th triangle of the l-th set.
+template <size_t N>
+struct circumcircles {
+  void update(size_t l, size_t i, const point* points, const triangle& t) {
+    const auto& a = points[t[0]];
+    const auto [u, v, o] =
+        circumcircle_intersection_cache(a, points[t[1]], points[t[2]]);
+    ax[i][l] = a[0];
+    ay[i][l] = a[1];
+    x[i][l] = u;
+    y[i][l] = v;
+    orientation[i][l] = o;
+  }
+
+  // Tests the new point of every set against its first 'size' triangles.
+  void test(const row& px, const row& py, size_t size) noexcept {
+    for (size_t i = 0; i < size; ++i)
+      for (size_t l = 0; l < lanes; ++l)
+        conflict[i][l] = circumcircle_intersection(
+            point{ax[i][l], ay[i][l]}, {x[i][l], y[i][l], orientation[i][l]},
+            point{px[l], py[l]});
+  }
+
+  static constexpr size_t capacity = fixed::max_triangles<N>;
+  std::array<row, capacity> ax{}, ay{}, x{}, y{}, orientation{};
+  std::array<std::array<uint32_t, lanes>, capacity> conflict{};
+};
+
+// Storage for the lockstep triangulation of a group of sets.
+template <size_t N>
+struct group {
+  std::array<fixed::detail::ghost_triangulation<N>, lanes> sets{};
+  circumcircles<N> cache{};
+
+  // Triangulates the given sets and appends their triangles to the result.
+  void triangulate(const std::vector<point>& points,
+                   const std::vector<size_t>& offsets, const size_t* indices,
+                   size_t count, std::vector<triangle>& result,
+                   std::vector<size_t>& sizes) {
+    std::array<const point*, lanes> first{};
+    std::array<size_t, lanes> n{};
+    std::array<bool, lanes> active{};
+    size_t steps = 0;
+    for (size_t l = 0; l < count; ++l) {
+      const auto s = indices[l];
+      first[l] = points.data() + offsets[s];
+      n[l] = offsets[s + 1] - offsets[s];
+      active[l] = sets[l].initialize(first[l], n[l]);
+      if (!active[l]) continue;
+      cache.update(l, 0, first[l], sets[l].result[0]);
+      steps = std::max(steps, n[l]);
+    }
+
+    row px{}, py{};
+    for (size_t pid = 1; pid < steps; ++pid) {
+      size_t size = 0;
+      for (size_t l = 0; l < count; ++l) {
+        if (!active[l] || (pid >= n[l])) continue;
+        px[l] = first[l][pid][0];
+        py[l] = first[l][pid][1];
+        size = std::max(size, sets[l].result.size());
+      }
+      cache.test(px, py, size);
+
+      for (size_t l = 0; l < count; ++l) {
+        auto& set = sets[l];
+        if (!active[l] || (pid >= n[l]) || set.inserted(pid)) continue;
+        const auto old = set.result.size();
+        set.insert(first[l], pid,
+                   [&](size_t i) { return bool(cache.conflict[i][l]); });
+        // Only removed slots and appended triangles have changed.
+        const auto m = set.result.size();
+        for (auto i : set.bad_triangles)
+          if (i < m) cache.update(l, i, first[l], set.result[i]);
+        for (auto i = old; i < m; ++i)
+          cache.update(l, i, first[l], set.result[i]);
+      }
+    }
+
+    for (size_t l = 0; l < count; ++l) {
+      const auto& triangles = sets[l].result;
+      sizes[indices[l]] = active[l] ? triangles.size() : 0;
+      if (active[l])
+        result.insert(result.end(), triangles.begin(), triangles.end());
+    }
+  }
+};
+
+}  // namespace detail
+
+// Returns the counterclockwise Delaunay triangles of every point set.
+// Set s consists of the points in the range [offsets[s], offsets[s + 1]).
+// For every set, the result is the same as for 'fixed::triangulation<N>'.
+// Throws if the offsets are invalid or a set has more than N points.
+template <size_t N = 64>
+triangle_sets triangulation(const std::vector<point>& points,
+                            const std::vector<size_t>& offsets) {
+  static_assert(N >= 3);
+  if (offsets.empty() || (offsets.front() != 0) ||
+      (offsets.back() != points.size()) ||
+      !std::is_sorted(offsets.begin(), offsets.end()))
+    throw std::invalid_argument("Offsets of point sets are invalid.");
+  const auto sets = offsets.size() - 1;
+  const auto size = [&offsets](size_t s) {
+    return offsets[s + 1] - offsets[s];
+  };
+  for (size_t s = 0; s < sets; ++s)
+    if (size(s) > N)
+      throw std::length_error("Too many points in set of batch.");
+
+  // Sets of similar size keep all lanes of a group busy.
+  std::vector<size_t> order(sets);
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t a, size_t b) { return size(a) < size(b); });
+
+  triangle_sets result{};
+  result.offsets.assign(sets + 1, 0);
+  if (sets == 0) return result;
+  const auto groups = (sets + lanes - 1) / lanes;
+  const auto threads = std::min(groups, thread_count(points.size(), 1 << 10));
+  std::vector<std::vector<triangle>> buffers(threads);
+  std::vector<size_t> sizes(sets);
+  parallel_for(groups, threads, [&](size_t thread, size_t first, size_t last) {
+    // The storage of a group is too large for the stack.
+    const auto g = std::make_unique<detail::group<N>>();
+    for (auto i = first; i < last; ++i) {
+      const auto begin = i * lanes;
+      const auto count = std::min(lanes, sets - begin);
+      g->triangulate(points, offsets, order.data() + begin, count,
+                     buffers[thread], sizes);
+    }
+  });
+
+  std::partial_sum(sizes.begin(), sizes.end(), result.offsets.begin() + 1);
+  result.triangles.resize(result.offsets.back());
+  // The partition of groups is the same as before.
+  parallel_for(groups, threads, [&](size_t thread, size_t first, size_t last) {
+    auto from = buffers[thread].begin();
+    for (auto s = order.begin() + first * lanes;
+         s != order.begin() + std::min(last * lanes, sets); ++s) {
+      std::copy(from, from + sizes[*s],
+                result.triangles.begin() + result.offsets[*s]);
+      from += sizes[*s];
+    }
+  });
+  return result;
+}
+
+}  // namespace lyrahgames::delaunay::batch
@@ -1,13 +1,19 @@
 #pragma once
 #include <algorithm>
 #include <array>
+#include <functional>
+#include <limits>
 #include <map>
+#include <memory>
 #include <vector>
 // #include <set>
 // #include <unordered_map>
 // #include <unordered_set>
 //
+#include <lyrahgames/delaunay/cavity.hpp>
+#include <lyrahgames/delaunay/connectivity.hpp>
 #include <lyrahgames/delaunay/geometry.hpp>
+#include <lyrahgames/delaunay/statistics.hpp>
 
 namespace lyrahgames::delaunay::bowyer_watson {
 
@@ -30,22 +36,32 @@ struct triangle : public std::array<size_t, 3> {
   }
 };
 
-std::vector<triangle> triangulation(std::vector<point>& points) {
+// If the connectivity is requested, the neighbors of all triangles and
+// the triangles around each vertex will be filled during the final pass.
+// Events of the construction are reported to the statistics policy.
+// All containers, including the result, use the given allocator template.
+template <template <typename> typename Allocator = std::allocator,
+          typename Statistics = no_statistics>
+std::vector<triangle, Allocator<triangle>> triangulation(
+    std::vector<point>& points, connectivity<3>* adjacency = nullptr,
+    Statistics&& statistics = {}) {
   // Construct regular super triangle which contains all given points.
   const auto bounds = bounding_triangle(bounding_circle(bounding_box(points)));
-  std::vector<triangle> triangles{
+  std::vector<triangle, Allocator<triangle>> triangles{
       {reinterpret_cast<size_t>(&bounds[0]),  //
        reinterpret_cast<size_t>(&bounds[1]),  //
        reinterpret_cast<size_t>(&bounds[2])},
   };
 
   // Initialize structures for the intersection polygon.
-  std::map<edge, int> polygon{};
+  std::map<edge, int, std::less<edge>, Allocator<std::pair<const edge, int>>>
+      polygon{};
   // std::unordered_map<edge, int, edge::hash> polygon{};
-  std::vector<size_t> bad_triangles{};
+  std::vector<size_t, Allocator<size_t>> bad_triangles{};
 
   // Incrementally insert every point.
   for (const auto& p : points) {
+    statistics.insert();
     // Clear the old polygon.
     polygon.clear();
     bad_triangles.clear();
@@ -66,6 +82,9 @@ std::vector<triangle> triangulation(std::vector<point>& points) {
       }
     }
 
+    statistics.test_incircle(triangles.size());
+    const auto old_size = triangles.size();
+
     // Generate a new triangle connected to the new point for
     // every boundary edge in the polygon.
     size_t bad_id = 0;
@@ -83,12 +102,15 @@ std::vector<triangle> triangulation(std::vector<point>& points) {
       if (i != 1) continue;
       triangles.push_back(triangle{e[0], e[1], reinterpret_cast<size_t>(&p)});
     }
+    statistics.cavity(bad_triangles.size(),
+                      bad_triangles.size() + triangles.size() - old_size);
   }
 
   // Compute the result vector of triangles by removing references
   // to the super triangle.
-  std::vector<triangle> result{};
+  std::vector<triangle, Allocator<triangle>> result{};
   result.reserve(triangles.size());
+  if (adjacency) adjacency->reset(points.size());
   for (const auto& t : triangles) {
     const auto a =
         static_cast<size_t>(reinterpret_cast<const point*>(t[0]) - &points[0]);
@@ -97,9 +119,12 @@ std::vector<triangle> triangulation(std::vector<point>& points) {
     const auto c =
         static_cast<size_t>(reinterpret_cast<const point*>(t[2]) - &points[0]);
 
-    if ((a < points.size()) && (b < points.size()) && (c < points.size()))
+    if ((a < points.size()) && (b < points.size()) && (c < points.size())) {
       result.emplace_back(a, b, c);
+      if (adjacency) adjacency->count(result.back());
+    }
   }
+  if (adjacency) adjacency->assemble(result);
 
   return result;
 }
@@ -109,10 +134,17 @@ namespace experimental {
 // This triangulation precomputes structures for the circumcircle intersection
 // routine for every triangle and therefore speeds up the process.
 // On the other hand, more memory is needed.
-std::vector<triangle> triangulation(std::vector<point>& points) {
+// If requested, the squared circumradii of the returned triangles
+// are derived from these structures in the final pass.
+template <template <typename> typename Allocator = std::allocator,
+          typename Statistics = no_statistics>
+std::vector<triangle, Allocator<triangle>> triangulation(
+    std::vector<point>& points, connectivity<3>* adjacency = nullptr,
+    std::vector<float, Allocator<float>>* squared_radii = nullptr,
+    Statistics&& statistics = {}) {
   // Construct regular super triangle which contains all given points.
   const auto bounds = bounding_triangle(bounding_circle(bounding_box(points)));
-  std::vector<triangle> triangles{
+  std::vector<triangle, Allocator<triangle>> triangles{
       {reinterpret_cast<size_t>(&bounds[0]),  //
        reinterpret_cast<size_t>(&bounds[1]),  //
        reinterpret_cast<size_t>(&bounds[2])},
@@ -121,22 +153,25 @@ std::vector<triangle> triangulation(std::vector<point>& points) {
   triangles.reserve(2 * points.size() + 3);
 
   // Precompute circumcircle intersection for super triangle.
-  std::vector<std::array<float, 3>> cache{circumcircle_intersection_cache(
-      *reinterpret_cast<const point*>(triangles[0][0]),
-      *reinterpret_cast<const point*>(triangles[0][1]),
-      *reinterpret_cast<const point*>(triangles[0][2]))};
+  std::vector<std::array<float, 3>, Allocator<std::array<float, 3>>> cache{
+      circumcircle_intersection_cache(
+          *reinterpret_cast<const point*>(triangles[0][0]),
+          *reinterpret_cast<const point*>(triangles[0][1]),
+          *reinterpret_cast<const point*>(triangles[0][2]))};
   cache.reserve(2 * points.size() + 3);
 
   // Initialize structures for the intersection polygon.
-  std::map<edge, int> polygon{};
+  std::map<edge, int, std::less<edge>, Allocator<std::pair<const edge, int>>>
+      polygon{};
   // std::unordered_map<edge, int, edge::hash> polygon(32);
   // std::set<edge> polygon{};
   // std::unordered_set<edge, edge::hash> polygon{};
   // std::vector<size_t> bad_triangles(32);
-  std::vector<size_t> bad_triangles(32);
+  std::vector<size_t, Allocator<size_t>> bad_triangles(32);
 
   // Incrementally add every point.
   for (const auto& p : points) {
+    statistics.insert();
     // Clear old polygon.
     polygon.clear();
     bad_triangles.clear();
@@ -169,6 +204,9 @@ std::vector<triangle> triangulation(std::vector<point>& points) {
       }
     }
 
+    statistics.test_incircle(triangles.size());
+    const auto old_size = triangles.size();
+
     // Generate a new triangle connected to the new point for
     // every boundary edge in the polygon.
     size_t bad_id = 0;
@@ -196,13 +234,18 @@ std::vector<triangle> triangulation(std::vector<point>& points) {
           *reinterpret_cast<const point*>(triangles.back()[1]),
           *reinterpret_cast<const point*>(triangles.back()[2])));
     }
+    statistics.cavity(bad_triangles.size(),
+                      bad_triangles.size() + triangles.size() - old_size);
   }
 
   // Construct the result vector by adding all triangles
   // not referencing points of the bounding triangle.
-  std::vector<triangle> result{};
+  std::vector<triangle, Allocator<triangle>> result{};
   result.reserve(triangles.size());
-  for (const auto& t : triangles) {
+  if (adjacency) adjacency->reset(points.size());
+  if (squared_radii) squared_radii->clear();
+  for (size_t i = 0; i < triangles.size(); ++i) {
+    const auto& t = triangles[i];
     const auto a =
         static_cast<size_t>(reinterpret_cast<const point*>(t[0]) - &points[0]);
     const auto b =
@@ -210,13 +253,159 @@ std::vector<triangle> triangulation(std::vector<point>& points) {
     const auto c =
         static_cast<size_t>(reinterpret_cast<const point*>(t[2]) - &points[0]);
 
-    if ((a < points.size()) && (b < points.size()) && (c < points.size()))
+    if ((a < points.size()) && (b < points.size()) && (c < points.size())) {
       result.emplace_back(a, b, c);
+      if (adjacency) adjacency->count(result.back());
+      // The cached values are twice the circumcenter relative to
+      // the first vertex scaled by the orientation.
+      if (squared_radii) {
+        const auto [x, y, orientation] = cache[i];
+        squared_radii->push_back((x * x + y * y) /
+                                 (4 * orientation * orientation));
+      }
+    }
   }
+  if (adjacency) adjacency->assemble(result);
 
   return result;
 }
 
 }  // namespace experimental
 
+namespace ghost {
+
+// Instead of a numeric super triangle, this triangulation connects every
+// edge of the convex hull to a symbolic vertex at infinity.
+// The resulting ghost triangles are stored separately as directed hull edges
+// whose left side is the exterior. A point is in conflict with a ghost
+// triangle if it lies strictly left of its edge or in the interior of
+// the edge itself. As a consequence, the predicates never see artificial
+// coordinates and the real triangles can be returned without filtering.
+// All real triangles are stored in counterclockwise order.
+
+constexpr size_t infinity = std::numeric_limits<size_t>::max();
+
+template <typename Point>
+inline bool ghost_conflict(const Point& a, const Point& b, const Point& p) {
+  if (counterclockwise(a, b, p)) return true;
+  if (clockwise(a, b, p)) return false;
+  return strictly_between(a, b, p);
+}
+
+template <template <typename> typename Allocator = std::allocator,
+          typename Point, typename Statistics = no_statistics>
+std::vector<triangle, Allocator<triangle>> triangulation(
+    const std::vector<Point>& points, connectivity<3>* adjacency = nullptr,
+    Statistics&& statistics = {}) {
+  using hull_edge = std::array<size_t, 2>;
+  std::vector<triangle, Allocator<triangle>> triangles{};
+  if (adjacency) adjacency->reset(points.size());
+
+  // Find the first three points that are not collinear.
+  const auto equal = [](const Point& x, const Point& y) {
+    return (x[0] == y[0]) && (x[1] == y[1]);
+  };
+  const auto n = points.size();
+  size_t seed[3] = {0, 1, 0};
+  while ((seed[1] < n) && equal(points[0], points[seed[1]])) ++seed[1];
+  if (seed[1] >= n) return triangles;
+  seed[2] = seed[1] + 1;
+  while ((seed[2] < n) &&
+         !counterclockwise(points[0], points[seed[1]], points[seed[2]]) &&
+         !clockwise(points[0], points[seed[1]], points[seed[2]]))
+    ++seed[2];
+  if (seed[2] >= n) return triangles;
+  if (clockwise(points[0], points[seed[1]], points[seed[2]]))
+    std::swap(seed[1], seed[2]);
+
+  triangles.push_back({seed[0], seed[1], seed[2]});
+  std::vector<hull_edge, Allocator<hull_edge>> ghosts{
+      {seed[1], seed[0]}, {seed[2], seed[1]}, {seed[0], seed[2]}};
+
+  // The polygon stores every edge of the cavity together with
+  // its direction in the removed element that inserted it last.
+  struct directed_edge {
+    size_t from, to;
+    int count = 0;
+  };
+  std::map<edge, directed_edge, std::less<edge>,
+           Allocator<std::pair<const edge, directed_edge>>>
+      polygon{};
+  const auto add_edge = [&polygon](size_t a, size_t b) {
+    auto& e = polygon[{a, b}];
+    e.from = a;
+    e.to = b;
+    ++e.count;
+  };
+  std::vector<size_t, Allocator<size_t>> bad_triangles{};
+  std::vector<size_t, Allocator<size_t>> bad_ghosts{};
+  std::vector<triangle, Allocator<triangle>> new_triangles{};
+  std::vector<hull_edge, Allocator<hull_edge>> new_ghosts{};
+
+  for (size_t pid = 1; pid < n; ++pid) {
+    if ((pid == seed[1]) || (pid == seed[2])) continue;
+    const auto& p = points[pid];
+
+    polygon.clear();
+    bad_triangles.clear();
+    bad_ghosts.clear();
+
+    // A duplicated point may only be reported to be in conflict with
+    // triangles it is a vertex of. It will not be inserted.
+    bool duplicate = false;
+    for (size_t i = 0; i < triangles.size(); ++i) {
+      const auto& t = triangles[i];
+      if (!circumcircle_intersection(points[t[0]], points[t[1]],
+                                     points[t[2]], p))
+        continue;
+      duplicate |= equal(points[t[0]], p) || equal(points[t[1]], p) ||
+                   equal(points[t[2]], p);
+      bad_triangles.push_back(i);
+      add_edge(t[0], t[1]);
+      add_edge(t[1], t[2]);
+      add_edge(t[2], t[0]);
+    }
+    for (size_t i = 0; i < ghosts.size(); ++i) {
+      const auto [a, b] = ghosts[i];
+      if (!ghost_conflict(points[a], points[b], p)) continue;
+      bad_ghosts.push_back(i);
+      add_edge(a, b);
+      add_edge(b, infinity);
+      add_edge(infinity, a);
+    }
+    statistics.test_incircle(triangles.size());
+    statistics.test_orientation(ghosts.size());
+    if (duplicate || (bad_triangles.empty() && bad_ghosts.empty())) {
+      statistics.skip_duplicate();
+      continue;
+    }
+    statistics.insert();
+
+    // Connect every directed boundary edge of the cavity to the new point.
+    new_triangles.clear();
+    new_ghosts.clear();
+    for (const auto& [_, e] : polygon) {
+      if (e.count != 1) continue;
+      if (e.from == infinity)
+        new_ghosts.push_back({e.to, pid});
+      else if (e.to == infinity)
+        new_ghosts.push_back({pid, e.from});
+      else
+        new_triangles.push_back({e.from, e.to, pid});
+    }
+    statistics.cavity(bad_triangles.size() + bad_ghosts.size(),
+                      new_triangles.size() + new_ghosts.size());
+    delaunay::detail::replace(triangles, bad_triangles, new_triangles);
+    delaunay::detail::replace(ghosts, bad_ghosts, new_ghosts);
+  }
+
+  if (adjacency) {
+    for (const auto& t : triangles) adjacency->count(t);
+    adjacency->assemble(triangles);
+  }
+  return triangles;
+}
+
+}  // namespace ghost
+
 }  // namespace lyrahgames::delaunay::bowyer_watson
\ No newline at end of file
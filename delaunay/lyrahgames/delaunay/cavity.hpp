@@ -0,0 +1,29 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+
+namespace lyrahgames::delaunay::detail {
+
+// Overwrite the slots of removed elements by new elements
+// and remove or append the remaining ones.
+// The containers only need to provide random access, 'size', 'push_back',
+// 'back' and 'pop_back'. So it works for heap-free containers as well and
+// can be used in constant expressions.
+template <typename Elements, typename Indices, typename Created>
+constexpr void replace(Elements& elements, Indices& bad,
+                       const Created& created) {
+  size_t i = 0;
+  for (; (i < bad.size()) && (i < created.size()); ++i)
+    elements[bad[i]] = created[i];
+  for (size_t j = i; j < created.size(); ++j) elements.push_back(created[j]);
+  // Remaining slots are erased by swapping with the back
+  // beginning with the largest index to not move removed elements.
+  std::sort(bad.begin() + i, bad.end(), std::greater<size_t>{});
+  for (; i < bad.size(); ++i) {
+    elements[bad[i]] = elements.back();
+    elements.pop_back();
+  }
+}
+
+}  // namespace lyrahgames::delaunay::detail
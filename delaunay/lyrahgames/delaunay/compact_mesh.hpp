@@ -0,0 +1,490 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+//
+#include <lyrahgames/delaunay/delaunay.hpp>
+#include <lyrahgames/delaunay/hilbert.hpp>
+#include <lyrahgames/delaunay/statistics.hpp>
+
+namespace lyrahgames::delaunay::experimental_3d::compact {
+
+// Tetrahedral mesh with a packed element layout of 32 bytes per tetrahedron.
+// Vertices are stored as 32-bit indices and every neighbor is stored as
+// a 32-bit link (t << 2) | f where t is the index of the neighboring
+// tetrahedron and f the index of the shared face inside of it.
+// The face with index i is the face opposite to vertex i.
+// Circumspheres can optionally be cached in a parallel array.
+// Tetrahedra (a, b, c, d) are positively oriented which means that
+// d lies on the positive side of the face (a, b, c).
+
+struct packed_tetrahedron {
+  std::array<uint32_t, 4> vertices;
+  std::array<uint32_t, 4> neighbors;
+};
+static_assert(sizeof(packed_tetrahedron) == 32);
+
+// Symbolic vertex of the ghost tetrahedra. It is always stored last.
+constexpr uint32_t infinity = std::numeric_limits<uint32_t>::max();
+// Link of a hull face after the ghost tetrahedra have been removed.
+constexpr uint32_t no_neighbor = std::numeric_limits<uint32_t>::max();
+// The link of face 3 of tetrahedron 2^30 - 1 would equal no_neighbor.
+constexpr size_t max_tetrahedra = (size_t{1} << 30) - 1;
+
+constexpr uint32_t link(uint32_t t, uint32_t f) noexcept {
+  return (t << 2) | f;
+}
+static_assert(link(max_tetrahedra - 1, 3) < no_neighbor);
+constexpr uint32_t tetrahedron_of(uint32_t l) noexcept { return l >> 2; }
+constexpr uint32_t face_of(uint32_t l) noexcept { return l & 3; }
+
+// Vertices of the face opposite to vertex i ordered such that
+// vertex i lies on the positive side of the face.
+constexpr uint32_t face_vertices[4][3] = {
+    {1, 3, 2}, {0, 2, 3}, {0, 3, 1}, {0, 1, 2}};
+
+// The predicates are evaluated in double precision. They are not exact,
+// but their rounding errors are far smaller than the ones of the float
+// predicates which fail for nearly flat tetrahedra at the convex hull.
+inline double orientation(const point& a, const point& b, const point& c,
+                          const point& d) noexcept {
+  const double ux = double(b.x) - a.x, uy = double(b.y) - a.y,
+               uz = double(b.z) - a.z;
+  const double vx = double(c.x) - a.x, vy = double(c.y) - a.y,
+               vz = double(c.z) - a.z;
+  const double wx = double(d.x) - a.x, wy = double(d.y) - a.y,
+               wz = double(d.z) - a.z;
+  return (uy * vz - uz * vy) * wx + (uz * vx - ux * vz) * wy +
+         (ux * vy - uy * vx) * wz;
+}
+
+inline bool ghost_conflict(const point& a, const point& b, const point& c,
+                           const point& p) noexcept {
+  const auto o = orientation(a, b, c, p);
+  if (o > 0) return true;
+  if (o < 0) return false;
+  return ghost::circumcircle_intersection(a, b, c, p);
+}
+
+// Incremental Bowyer-Watson construction on the packed layout.
+// Points are located by a visibility walk starting at the last
+// created tetrahedron and the cavity is found by a breadth-first search
+// over the neighbor links. Instead of hash maps, membership in the cavity
+// is stored as a mark in a parallel array. The convex hull is closed
+// by ghost tetrahedra (a, b, c, infinity) whose face (a, b, c) has
+// the exterior on its positive side.
+// New tetrahedra are first written into the slots of the removed ones and
+// then appended. Hence, the storage order follows the insertion order and
+// points inserted along a space-filling curve result in neighboring
+// tetrahedra being stored close to each other.
+// The mesh references the given points which have to outlive it.
+template <bool Cache = true,
+          template <typename> typename Allocator = std::allocator>
+class mesh {
+ public:
+  template <typename T>
+  using vector = std::vector<T, Allocator<T>>;
+
+  explicit mesh(const std::vector<point>& points) : points_{&points} {
+    if (points.size() >= infinity)
+      throw std::length_error("Too many points for 32-bit vertex indices.");
+  }
+
+  // Inserts the point with the given index. Points are buffered
+  // until four of them are not coplanar. Duplicates are skipped.
+  template <typename Statistics = no_statistics>
+  void insert(uint32_t v, Statistics&& statistics = {});
+
+  // Removes ghost tetrahedra and unused slots while keeping the order.
+  // Links to ghost tetrahedra become 'no_neighbor'.
+  // Afterwards, no further points can be inserted.
+  void compact();
+
+  const auto& points() const noexcept { return *points_; }
+  const auto& tetrahedra() const noexcept { return tetrahedra_; }
+  const auto& spheres() const noexcept requires Cache { return spheres_; }
+
+  bool is_ghost(uint32_t t) const noexcept {
+    return tetrahedra_[t].vertices[3] == infinity;
+  }
+  bool is_unused(uint32_t t) const noexcept {
+    return tetrahedra_[t].vertices[0] == infinity;
+  }
+
+ private:
+  const point& position(uint32_t v) const noexcept { return (*points_)[v]; }
+
+  static bool equal(const point& x, const point& y) noexcept {
+    return (x.x == y.x) && (x.y == y.y) && (x.z == y.z);
+  }
+
+  sphere circumsphere_of(uint32_t t) const noexcept {
+    if constexpr (Cache) {
+      return spheres_[t];
+    } else {
+      const auto [a, b, c, d] = tetrahedra_[t].vertices;
+      return precise_circumsphere(position(a), position(b), position(c),
+                                  position(d));
+    }
+  }
+
+  template <typename Statistics>
+  bool conflict(uint32_t t, const point& p, Statistics& statistics) const {
+    const auto [a, b, c, d] = tetrahedra_[t].vertices;
+    if (d == infinity) {
+      statistics.test_orientation();
+      return ghost_conflict(position(a), position(b), position(c), p);
+    }
+    statistics.test_incircle();
+    // The sphere decides unless the point is too close to its surface
+    // with respect to the rounding errors of the float computation.
+    const auto s = circumsphere_of(t);
+    const auto distance = sqnorm(p - s.c) - s.r2;
+    const auto tolerance = 1e-6f * (s.r2 + 2 * (sqnorm(p) + sqnorm(s.c)));
+    if (distance < -tolerance) return true;
+    if (distance > tolerance) return false;
+    return insphere(position(a), position(b), position(c), position(d), p) >
+           0;
+  }
+
+  template <typename Statistics>
+  uint32_t locate(const point& p, Statistics& statistics) const;
+
+  uint32_t allocate();
+  void connect();
+  void initialize();
+
+  template <typename Statistics>
+  void insert_point(uint32_t v, Statistics& statistics);
+
+  const std::vector<point>* points_;
+  vector<packed_tetrahedron> tetrahedra_{};
+  vector<sphere> spheres_{};
+  // Cavity marks of the current insertion are 2 * epoch and 2 * epoch + 1.
+  vector<uint32_t> marks_{};
+  uint32_t epoch_ = 0;
+  vector<uint32_t> unused_{};
+  uint32_t last_ = 0;
+
+  // Points inserted before the first tetrahedron could be constructed.
+  vector<uint32_t> pending_{};
+  std::array<uint32_t, 4> seed_{};
+  size_t seeds_ = 0;
+
+  struct boundary_face {
+    std::array<uint32_t, 3> vertices;
+    uint32_t link;
+  };
+  struct edge_link {
+    uint64_t key;
+    uint32_t link;
+  };
+  vector<uint32_t> cavity_{};
+  vector<boundary_face> boundary_{};
+  vector<edge_link> edges_{};
+};
+
+template <bool Cache, template <typename> typename Allocator>
+uint32_t mesh<Cache, Allocator>::allocate() {
+  if (!unused_.empty()) {
+    const auto t = unused_.back();
+    unused_.pop_back();
+    return t;
+  }
+  if (tetrahedra_.size() >= max_tetrahedra)
+    throw std::length_error("Too many tetrahedra for 30-bit links.");
+  tetrahedra_.emplace_back();
+  marks_.push_back(0);
+  if constexpr (Cache) spheres_.emplace_back();
+  return tetrahedra_.size() - 1;
+}
+
+// Every face sharing the new vertex has been recorded together with the
+// opposite edge. Faces with equal edges are neighbors.
+template <bool Cache, template <typename> typename Allocator>
+void mesh<Cache, Allocator>::connect() {
+  std::sort(edges_.begin(), edges_.end(),
+            [](const auto& x, const auto& y) { return x.key < y.key; });
+  for (size_t i = 0; i + 1 < edges_.size(); i += 2) {
+    const auto x = edges_[i].link;
+    const auto y = edges_[i + 1].link;
+    tetrahedra_[tetrahedron_of(x)].neighbors[face_of(x)] = y;
+    tetrahedra_[tetrahedron_of(y)].neighbors[face_of(y)] = x;
+  }
+}
+
+template <bool Cache, template <typename> typename Allocator>
+void mesh<Cache, Allocator>::initialize() {
+  auto [a, b, c, d] = seed_;
+  if (orientation(position(a), position(b), position(c), position(d)) < 0)
+    std::swap(b, c);
+  const auto t = allocate();
+  tetrahedra_[t].vertices = {a, b, c, d};
+  if constexpr (Cache)
+    spheres_[t] = precise_circumsphere(position(a), position(b), position(c),
+                                       position(d));
+  last_ = t;
+
+  edges_.clear();
+  for (uint32_t f = 0; f < 4; ++f) {
+    const auto v = tetrahedra_[t].vertices;
+    const auto& fv = face_vertices[f];
+    const auto g = allocate();
+    tetrahedra_[g].vertices = {v[fv[0]], v[fv[2]], v[fv[1]], infinity};
+    tetrahedra_[g].neighbors[3] = link(t, f);
+    tetrahedra_[t].neighbors[f] = link(g, 3);
+    for (uint32_t i = 0; i < 3; ++i) {
+      const auto x = tetrahedra_[g].vertices[(i + 1) % 3];
+      const auto y = tetrahedra_[g].vertices[(i + 2) % 3];
+      edges_.push_back(
+          {(uint64_t{std::min(x, y)} << 32) | std::max(x, y), link(g, i)});
+    }
+  }
+  connect();
+}
+
+template <bool Cache, template <typename> typename Allocator>
+template <typename Statistics>
+void mesh<Cache, Allocator>::insert(uint32_t v, Statistics&& statistics) {
+  if (seeds_ == 4) {
+    insert_point(v, statistics);
+    return;
+  }
+
+  // Every point is only tested against the current stage of the seed.
+  // A point failing one stage also fails all following stages.
+  const auto& p = position(v);
+  const auto& s = seed_;
+  bool advance = false;
+  if (seeds_ == 0)
+    advance = true;
+  else if (seeds_ == 1)
+    advance = !equal(position(s[0]), p);
+  else if (seeds_ == 2)
+    advance = sqnorm(cross(position(s[1]) - position(s[0]),
+                           p - position(s[0]))) != 0;
+  else
+    // The orientation is not exactly zero for duplicates of the seed.
+    advance = !equal(position(s[1]), p) && !equal(position(s[2]), p) &&
+              (orientation(position(s[0]), position(s[1]), position(s[2]),
+                           p) != 0);
+  if (!advance) {
+    pending_.push_back(v);
+    return;
+  }
+  seed_[seeds_++] = v;
+  if (seeds_ < 4) return;
+
+  for (uint32_t i = 0; i < 4; ++i) statistics.insert();
+  initialize();
+  for (const auto u : pending_) insert_point(u, statistics);
+  pending_ = {};
+}
+
+template <bool Cache, template <typename> typename Allocator>
+template <typename Statistics>
+uint32_t mesh<Cache, Allocator>::locate(const point& p,
+                                        Statistics& statistics) const {
+  auto t = last_;
+  if (is_ghost(t)) t = tetrahedron_of(tetrahedra_[t].neighbors[3]);
+  // The first face to test rotates with every step such that
+  // the walk cannot cycle in exact arithmetic.
+  for (size_t steps = 0; steps < tetrahedra_.size(); ++steps) {
+    if (is_ghost(t)) {
+      statistics.walk(steps);
+      return t;
+    }
+    const auto& [v, n] = tetrahedra_[t];
+    auto next = t;
+    for (uint32_t k = 0; k < 4; ++k) {
+      const auto f = (k + steps) & 3;
+      const auto& fv = face_vertices[f];
+      statistics.test_orientation();
+      if (orientation(position(v[fv[0]]), position(v[fv[1]]),
+                      position(v[fv[2]]), p) >= 0)
+        continue;
+      next = tetrahedron_of(n[f]);
+      break;
+    }
+    if (next == t) {
+      statistics.walk(steps);
+      return t;
+    }
+    t = next;
+  }
+
+  // Rounding errors may lead to cycles. Then, fall back to a linear search.
+  for (uint32_t i = 0; i < tetrahedra_.size(); ++i)
+    if (!is_unused(i) && conflict(i, p, statistics)) return i;
+  return no_neighbor;
+}
+
+template <bool Cache, template <typename> typename Allocator>
+template <typename Statistics>
+void mesh<Cache, Allocator>::insert_point(uint32_t v, Statistics& statistics) {
+  const auto& p = position(v);
+  const auto start = locate(p, statistics);
+  if (start == no_neighbor) {
+    statistics.skip_duplicate();
+    return;
+  }
+
+  if (++epoch_ == (uint32_t{1} << 31)) {
+    std::fill(marks_.begin(), marks_.end(), 0);
+    epoch_ = 1;
+  }
+  const auto inside = 2 * epoch_;
+  const auto outside = inside + 1;
+
+  cavity_.clear();
+  cavity_.push_back(start);
+  marks_[start] = inside;
+  for (size_t i = 0; i < cavity_.size(); ++i) {
+    for (const auto l : tetrahedra_[cavity_[i]].neighbors) {
+      const auto n = tetrahedron_of(l);
+      if ((marks_[n] == inside) || (marks_[n] == outside)) continue;
+      if (conflict(n, p, statistics)) {
+        marks_[n] = inside;
+        cavity_.push_back(n);
+      } else {
+        marks_[n] = outside;
+      }
+    }
+  }
+
+  // A duplicated point lies on a vertex of the tetrahedron it was located in.
+  for (const auto t : cavity_) {
+    for (const auto u : tetrahedra_[t].vertices) {
+      if ((u == infinity) || !equal(position(u), p)) continue;
+      statistics.skip_duplicate();
+      return;
+    }
+  }
+  statistics.insert();
+
+  // The new point has to see every boundary face of the cavity from its
+  // inside. Otherwise, rounding errors would produce inverted tetrahedra.
+  // In such a case, the tetrahedron behind the face is added to the cavity.
+  bool grown = true;
+  while (grown) {
+    grown = false;
+    boundary_.clear();
+    for (size_t i = 0; i < cavity_.size(); ++i) {
+      const auto& [vertices, neighbors] = tetrahedra_[cavity_[i]];
+      for (uint32_t f = 0; f < 4; ++f) {
+        const auto n = tetrahedron_of(neighbors[f]);
+        if (marks_[n] == inside) continue;
+        const auto& fv = face_vertices[f];
+        const std::array<uint32_t, 3> face{vertices[fv[0]], vertices[fv[1]],
+                                           vertices[fv[2]]};
+        if ((face[0] != infinity) && (face[1] != infinity) &&
+            (face[2] != infinity)) {
+          statistics.test_orientation();
+          if (orientation(position(face[0]), position(face[1]),
+                          position(face[2]), p) <= 0) {
+            marks_[n] = inside;
+            cavity_.push_back(n);
+            grown = true;
+            continue;
+          }
+        }
+        boundary_.push_back({face, neighbors[f]});
+      }
+    }
+  }
+
+  // Connect every boundary face of the cavity to the new point.
+  // A face (x, y, z) containing infinity becomes a ghost tetrahedron
+  // by an even permutation that moves infinity to the end.
+  edges_.clear();
+  size_t slot = 0;
+  for (const auto& [face, l] : boundary_) {
+    const auto t = (slot < cavity_.size()) ? cavity_[slot++] : allocate();
+    const auto [x, y, z] = face;
+    auto& tetrahedron = tetrahedra_[t];
+    uint32_t j = 0;
+    if (x == infinity)
+      tetrahedron.vertices = {v, z, y, infinity};
+    else if (y == infinity)
+      tetrahedron.vertices = {v, x, z, infinity};
+    else if (z == infinity)
+      tetrahedron.vertices = {v, y, x, infinity};
+    else {
+      tetrahedron.vertices = {x, y, z, v};
+      j = 3;
+    }
+    tetrahedron.neighbors[j] = l;
+    tetrahedra_[tetrahedron_of(l)].neighbors[face_of(l)] = link(t, j);
+    for (uint32_t i = 0; i < 4; ++i) {
+      if (i == j) continue;
+      uint32_t e[2];
+      for (uint32_t k = 0, m = 0; k < 4; ++k)
+        if ((k != i) && (k != j)) e[m++] = tetrahedron.vertices[k];
+      edges_.push_back(
+          {(uint64_t{std::min(e[0], e[1])} << 32) | std::max(e[0], e[1]),
+           link(t, i)});
+    }
+    if (j == 3) {
+      last_ = t;
+      if constexpr (Cache)
+        spheres_[t] =
+            precise_circumsphere(position(x), position(y), position(z), p);
+    }
+  }
+  connect();
+
+  for (; slot < cavity_.size(); ++slot) {
+    tetrahedra_[cavity_[slot]].vertices.fill(infinity);
+    unused_.push_back(cavity_[slot]);
+  }
+  statistics.cavity(cavity_.size(), boundary_.size());
+}
+
+template <bool Cache, template <typename> typename Allocator>
+void mesh<Cache, Allocator>::compact() {
+  vector<uint32_t> index(tetrahedra_.size(), no_neighbor);
+  uint32_t count = 0;
+  for (uint32_t t = 0; t < tetrahedra_.size(); ++t)
+    if (!is_unused(t) && !is_ghost(t)) index[t] = count++;
+
+  // New indices are never larger than the old ones.
+  for (uint32_t t = 0; t < tetrahedra_.size(); ++t) {
+    if (index[t] == no_neighbor) continue;
+    auto tetrahedron = tetrahedra_[t];
+    for (auto& l : tetrahedron.neighbors) {
+      const auto n = index[tetrahedron_of(l)];
+      l = (n == no_neighbor) ? no_neighbor : link(n, face_of(l));
+    }
+    tetrahedra_[index[t]] = tetrahedron;
+    if constexpr (Cache) spheres_[index[t]] = spheres_[t];
+  }
+  tetrahedra_.resize(count);
+  if constexpr (Cache) spheres_.resize(count);
+  tetrahedra_.shrink_to_fit();
+  spheres_.shrink_to_fit();
+  marks_ = {};
+  unused_ = {};
+  cavity_ = {};
+  boundary_ = {};
+  edges_ = {};
+}
+
+// Inserts all points along the Hilbert curve and compacts the mesh.
+// Less than four points or coplanar points result in an empty mesh.
+template <bool Cache = true,
+          template <typename> typename Allocator = std::allocator,
+          typename Statistics = no_statistics>
+auto triangulation(const std::vector<point>& points,
+                   Statistics&& statistics = {}) {
+  mesh<Cache, Allocator> result{points};
+  for (const auto i : hilbert_order(points)) result.insert(i, statistics);
+  result.compact();
+  return result;
+}
+
+}  // namespace lyrahgames::delaunay::experimental_3d::compact
@@ -0,0 +1,111 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace lyrahgames::delaunay {
+
+// Connectivity of a simplicial mesh whose elements consist of K vertices.
+// For every element, the neighbor at position i is the element sharing
+// the facet opposite to the vertex at position i.
+// For boundary facets, the neighbor is set to 'none'.
+// The elements incident to a vertex are stored in compressed sparse row format
+// such that the elements around vertex v are given by the range
+// [vertex_offsets[v], vertex_offsets[v + 1]) of vertex_elements.
+template <size_t K>
+struct connectivity {
+  static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+  // Prepare the structure to count vertex degrees of a mesh
+  // with the given number of vertices.
+  void reset(size_t vertex_count) {
+    neighbors.clear();
+    vertex_elements.clear();
+    vertex_offsets.assign(vertex_count + 1, 0);
+  }
+
+  // Count the element references to its vertices.
+  // Every element of the mesh has to be counted exactly once
+  // before calling 'assemble'.
+  template <typename Element>
+  void count(const Element& e) noexcept {
+    for (size_t i = 0; i < K; ++i) ++vertex_offsets[e[i] + 1];
+  }
+
+  // Use the counted vertex degrees to fill the CSR arrays
+  // and compute the neighbors of all elements.
+  template <typename Elements>
+  void assemble(const Elements& elements) {
+    // Exclusive prefix sum of vertex degrees.
+    for (size_t v = 1; v < vertex_offsets.size(); ++v)
+      vertex_offsets[v] += vertex_offsets[v - 1];
+
+    vertex_elements.resize(vertex_offsets.back());
+    std::vector<size_t> fill(vertex_offsets.begin(), vertex_offsets.end() - 1);
+    for (size_t i = 0; i < elements.size(); ++i)
+      for (size_t k = 0; k < K; ++k)
+        vertex_elements[fill[elements[i][k]]++] = i;
+
+    // The neighbor sharing a facet has to be incident to all vertices
+    // of the facet. So it suffices to search the elements around the
+    // facet vertex with the smallest degree.
+    neighbors.assign(elements.size(), {});
+    for (auto& n : neighbors) n.fill(none);
+    for (size_t i = 0; i < elements.size(); ++i) {
+      const auto& e = elements[i];
+      for (size_t k = 0; k < K; ++k) {
+        if (neighbors[i][k] != none) continue;
+
+        auto pivot = e[(k + 1) % K];
+        for (size_t j = 2; j < K; ++j) {
+          const auto v = e[(k + j) % K];
+          if (degree(v) < degree(pivot)) pivot = v;
+        }
+
+        for (auto it = vertex_offsets[pivot]; it < vertex_offsets[pivot + 1];
+             ++it) {
+          const auto other = vertex_elements[it];
+          if (other == i) continue;
+          const auto& f = elements[other];
+          // Find the vertex of the other element not contained in the facet.
+          size_t shared = 0;
+          size_t opposite = K;
+          for (size_t l = 0; l < K; ++l) {
+            bool found = false;
+            for (size_t j = 1; j < K; ++j) found |= (f[l] == e[(k + j) % K]);
+            if (found)
+              ++shared;
+            else
+              opposite = l;
+          }
+          if (shared != K - 1) continue;
+          neighbors[i][k] = other;
+          neighbors[other][opposite] = i;
+          break;
+        }
+      }
+    }
+  }
+
+  size_t degree(size_t vid) const noexcept {
+    return vertex_offsets[vid + 1] - vertex_offsets[vid];
+  }
+
+  std::vector<std::array<size_t, K>> neighbors{};
+  std::vector<size_t> vertex_offsets{};
+  std::vector<size_t> vertex_elements{};
+};
+
+// Compute the connectivity of an arbitrary list of elements
+// that was not constructed by one of the triangulation routines.
+template <size_t K, typename Elements>
+auto make_connectivity(const Elements& elements, size_t vertex_count) {
+  connectivity<K> result{};
+  result.reset(vertex_count);
+  for (const auto& e : elements) result.count(e);
+  result.assemble(elements);
+  return result;
+}
+
+}  // namespace lyrahgames::delaunay
@@ -0,0 +1,351 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+//
+#include <lyrahgames/delaunay/connectivity.hpp>
+#include <lyrahgames/delaunay/hilbert.hpp>
+#include <lyrahgames/delaunay/statistics.hpp>
+
+namespace lyrahgames::delaunay::convex_hull {
+
+// Incremental construction of the convex hull of points in 3D by the
+// randomized algorithm of Clarkson and Shor. Instead of tetrahedralizing
+// the interior, only the triangular faces of the hull are stored together
+// with their neighbors. The conflict graph assigns every point that has not
+// been inserted yet to one face it sees. So the visible region of a point is
+// found by a search over the faces starting at its conflict face. After the
+// insertion, the points of the removed faces only have to be tested against
+// the new faces. Orientation tests in double precision are the only
+// predicates. Their sign is only trusted beyond a forward error bound.
+// So points within roundoff of the hull, like nearly duplicated vertices,
+// are skipped instead of corrupting the surface.
+
+using face = std::array<size_t, 3>;
+
+constexpr size_t none = std::numeric_limits<size_t>::max();
+
+namespace detail {
+
+using real = std::array<double, 3>;
+
+// Positive if d lies on the positive side of the face (a, b, c)
+// whose vertices are counterclockwise when seen from there.
+constexpr double orientation(const real& a, const real& b, const real& c,
+                             const real& d) noexcept {
+  const real u{b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  const real v{c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+  const real w{d[0] - a[0], d[1] - a[1], d[2] - a[2]};
+  return (u[1] * v[2] - u[2] * v[1]) * w[0] +
+         (u[2] * v[0] - u[0] * v[2]) * w[1] +
+         (u[0] * v[1] - u[1] * v[0]) * w[2];
+}
+
+// True if d lies on the positive side of the face (a, b, c) and the sign
+// of the orientation is certain. The error bound is the one of the first
+// stage of Shewchuk's adaptive orient3d predicate.
+constexpr bool beyond(const real& a, const real& b, const real& c,
+                      const real& d) noexcept {
+  constexpr double epsilon = std::numeric_limits<double>::epsilon() / 2;
+  constexpr double bound = (7 + 56 * epsilon) * epsilon;
+  const real u{b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  const real v{c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+  const real w{d[0] - a[0], d[1] - a[1], d[2] - a[2]};
+  const auto uv0 = u[1] * v[2], vu0 = u[2] * v[1];
+  const auto uv1 = u[2] * v[0], vu1 = u[0] * v[2];
+  const auto uv2 = u[0] * v[1], vu2 = u[1] * v[0];
+  const auto determinant =
+      (uv0 - vu0) * w[0] + (uv1 - vu1) * w[1] + (uv2 - vu2) * w[2];
+  const auto permanent = (std::abs(uv0) + std::abs(vu0)) * std::abs(w[0]) +
+                         (std::abs(uv1) + std::abs(vu1)) * std::abs(w[1]) +
+                         (std::abs(uv2) + std::abs(vu2)) * std::abs(w[2]);
+  return determinant > bound * permanent;
+}
+
+constexpr double sqdistance(const real& a, const real& b) noexcept {
+  double result = 0;
+  for (size_t k = 0; k < 3; ++k) result += (b[k] - a[k]) * (b[k] - a[k]);
+  return result;
+}
+
+// Face of the hull whose neighbor at position i shares the edge
+// opposite to the vertex at position i.
+struct hull_face {
+  face v;
+  std::array<size_t, 3> neighbors;
+};
+
+// Finds four points spanning a tetrahedron of large volume. Returns
+// nothing if all points are coplanar. The last point lies on the
+// negative side of the first three.
+inline auto seed(const std::vector<real>& x) {
+  std::array<size_t, 4> result{};
+  const auto n = x.size();
+  for (size_t i = 1; i < n; ++i)
+    if (x[i][0] < x[result[0]][0]) result[0] = i;
+  double best = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const auto d = sqdistance(x[result[0]], x[i]);
+    if (d > best) {
+      best = d;
+      result[1] = i;
+    }
+  }
+  if (best == 0) return std::vector<size_t>{};
+  best = 0;
+  const auto& a = x[result[0]];
+  const auto& b = x[result[1]];
+  for (size_t i = 0; i < n; ++i) {
+    const auto& c = x[i];
+    const real u{b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const real v{c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    const real w{u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2],
+                 u[0] * v[1] - u[1] * v[0]};
+    const auto d = w[0] * w[0] + w[1] * w[1] + w[2] * w[2];
+    if (d > best) {
+      best = d;
+      result[2] = i;
+    }
+  }
+  if (best == 0) return std::vector<size_t>{};
+  best = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const auto d = std::abs(orientation(a, b, x[result[2]], x[i]));
+    if (d > best) {
+      best = d;
+      result[3] = i;
+    }
+  }
+  if (best == 0) return std::vector<size_t>{};
+  if (orientation(a, b, x[result[2]], x[result[3]]) > 0)
+    std::swap(result[1], result[2]);
+  return std::vector<size_t>(result.begin(), result.end());
+}
+
+}  // namespace detail
+
+// Returns the faces of the convex hull. They are counterclockwise when
+// seen from the outside. Points in the interior, on the boundary, or within
+// roundoff of the hull, including duplicates, are no vertices and reported
+// as skipped duplicates to the statistics policy. If all points are
+// coplanar, no faces are returned.
+// If the connectivity is requested, the neighbors of all faces
+// and the faces around each vertex are computed.
+template <typename Point, typename Statistics = no_statistics>
+std::vector<face> triangulation(const std::vector<Point>& points,
+                                connectivity<3>* adjacency = nullptr,
+                                Statistics&& statistics = {}) {
+  static_assert(dimension<Point>() == 3);
+  const auto n = points.size();
+  std::vector<face> result{};
+  if (adjacency) adjacency->reset(n);
+  // Points are stored along the Hilbert curve such that the conflict lists
+  // of a face refer to nearby memory.
+  const auto local = hilbert_order(points);
+  std::vector<detail::real> x(n);
+  for (size_t i = 0; i < n; ++i) x[i] = coordinates<3>(points[local[i]]);
+
+  const auto seed = detail::seed(x);
+  if (seed.empty()) {
+    if (adjacency) adjacency->assemble(result);
+    return result;
+  }
+  const auto [a, b, c, d] = std::array{seed[0], seed[1], seed[2], seed[3]};
+
+  // Faces are stored in stable slots whose conflict lists keep
+  // their capacity when the slot is reused.
+  std::vector<detail::hull_face> faces{{{a, b, c}, {2, 3, 1}},
+                                       {{a, d, b}, {2, 0, 3}},
+                                       {{b, d, c}, {3, 0, 1}},
+                                       {{a, c, d}, {2, 1, 0}}};
+  std::vector<std::vector<size_t>> outside(faces.size());
+  std::vector<char> alive(faces.size(), true);
+  std::vector<size_t> free{};
+  std::vector<size_t> conflict(n, none);
+  const auto sees = [&](size_t f, size_t p) {
+    const auto& [u, v, w] = faces[f].v;
+    return detail::beyond(x[u], x[v], x[w], x[p]);
+  };
+
+  for (size_t p = 0; p < n; ++p) {
+    if ((p == a) || (p == b) || (p == c) || (p == d)) continue;
+    size_t f = 0;
+    while ((f < 4) && !sees(f, p)) ++f;
+    statistics.test_orientation(std::min<size_t>(f + 1, 4));
+    if (f == 4) continue;
+    conflict[p] = f;
+    outside[f].push_back(p);
+  }
+
+  // A random insertion order bounds the expected number of conflicts.
+  // It is biased by rounds of doubling size that follow the Hilbert curve.
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::shuffle(order.begin(), order.end(), std::mt19937_64{n});
+  for (size_t first = 0, last = 1; first < n; first = last, last *= 2)
+    std::sort(order.begin() + first, order.begin() + std::min(last, n));
+
+  // Visit marks of faces and vertices and the new faces at horizon
+  // vertices. Horizon edges are given by a face and a local index.
+  std::vector<size_t> visited(faces.size(), none);
+  std::vector<char> visible(faces.size(), false);
+  std::vector<size_t> mark(n, none), start(n), end(n);
+  std::vector<size_t> stack{}, region{}, created{};
+  std::vector<std::pair<size_t, size_t>> horizon{};
+
+  for (auto q : order) {
+    if (conflict[q] == none) {
+      if ((q != a) && (q != b) && (q != c) && (q != d))
+        statistics.skip_duplicate();
+      continue;
+    }
+    statistics.insert();
+
+    // The faces visible from q form a connected region.
+    region.clear();
+    stack.assign(1, conflict[q]);
+    visited[conflict[q]] = q;
+    visible[conflict[q]] = true;
+    size_t tests = 0;
+    while (!stack.empty()) {
+      const auto f = stack.back();
+      stack.pop_back();
+      region.push_back(f);
+      for (auto g : faces[f].neighbors) {
+        if (visited[g] == q) continue;
+        visited[g] = q;
+        visible[g] = sees(g, q);
+        ++tests;
+        if (visible[g]) stack.push_back(g);
+      }
+    }
+    statistics.test_orientation(tests);
+
+    // The horizon has to be a simple cycle. Otherwise, roundoff errors
+    // have made the visible region no disk and the point is skipped.
+    horizon.clear();
+    for (auto f : region)
+      for (size_t i = 0; i < 3; ++i) {
+        const auto g = faces[f].neighbors[i];
+        if (!visible[g] || (visited[g] != q)) horizon.push_back({f, i});
+      }
+    const auto source = [&](size_t e) {
+      const auto [f, i] = horizon[e];
+      return faces[f].v[(i + 1) % 3];
+    };
+    const auto target = [&](size_t e) {
+      const auto [f, i] = horizon[e];
+      return faces[f].v[(i + 2) % 3];
+    };
+    bool simple = true;
+    for (size_t e = 0; e < horizon.size(); ++e) {
+      const auto u = source(e);
+      simple &= (mark[u] != q);
+      mark[u] = q;
+      start[u] = e;
+    }
+    // Following the edges from the first one has to visit all of them
+    // before returning.
+    for (size_t e = 0, steps = 1; simple && (steps <= horizon.size());
+         ++steps) {
+      const auto v = target(e);
+      simple &= (mark[v] == q);
+      e = start[v];
+      simple &= ((e == 0) == (steps == horizon.size()));
+    }
+    if (!simple) {
+      statistics.skip_duplicate();
+      auto& list = outside[conflict[q]];
+      list.erase(std::find(list.begin(), list.end(), q));
+      conflict[q] = none;
+      continue;
+    }
+
+    // Every edge of the horizon is connected to q. The new face keeps
+    // the orientation of the edge in its removed face.
+    created.clear();
+    for (size_t e = 0; e < horizon.size(); ++e) {
+      const auto [f, i] = horizon[e];
+      const auto g = faces[f].neighbors[i];
+      const auto u = source(e);
+      const auto v = target(e);
+      size_t h = faces.size();
+      if (free.empty()) {
+        faces.push_back({});
+        outside.emplace_back();
+        alive.push_back(true);
+        visited.push_back(none);
+        visible.push_back(false);
+      } else {
+        h = free.back();
+        free.pop_back();
+        alive[h] = true;
+      }
+      faces[h] = {{u, v, q}, {none, none, g}};
+      for (auto& k : faces[g].neighbors)
+        if (k == f) k = h;
+      start[u] = h;
+      end[v] = h;
+      created.push_back(h);
+    }
+    for (auto h : created) {
+      auto& [v, neighbors] = faces[h];
+      neighbors[0] = start[v[1]];
+      neighbors[1] = end[v[0]];
+    }
+    statistics.cavity(region.size(), created.size());
+
+    // Points outside of a removed face are outside of a new face or
+    // inside of the new hull. Numerically, they might only see an old
+    // face across the horizon.
+    tests = 0;
+    for (auto f : region) {
+      for (auto p : outside[f]) {
+        if (p == q) continue;
+        conflict[p] = none;
+        for (auto h : created) {
+          ++tests;
+          if (sees(h, p)) {
+            conflict[p] = h;
+            break;
+          }
+        }
+        if (conflict[p] == none) {
+          for (auto h : created) {
+            const auto g = faces[h].neighbors[2];
+            ++tests;
+            if (sees(g, p)) {
+              conflict[p] = g;
+              break;
+            }
+          }
+        }
+        if (conflict[p] != none) outside[conflict[p]].push_back(p);
+      }
+      outside[f].clear();
+      alive[f] = false;
+      visible[f] = false;
+      free.push_back(f);
+    }
+    conflict[q] = none;
+    statistics.test_orientation(tests);
+  }
+
+  result.reserve(faces.size() - free.size());
+  for (size_t f = 0; f < faces.size(); ++f) {
+    if (!alive[f]) continue;
+    const auto [u, v, w] = faces[f].v;
+    result.push_back({local[u], local[v], local[w]});
+    if (adjacency) adjacency->count(result.back());
+  }
+  if (adjacency) adjacency->assemble(result);
+  return result;
+}
+
+}  // namespace lyrahgames::delaunay::convex_hull
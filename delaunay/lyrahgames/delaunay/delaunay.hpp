@@ -1,37 +1,46 @@
 #pragma once
 #include <algorithm>
 #include <array>
-#include <map>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
 #include <type_traits>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
+//
+#include <lyrahgames/delaunay/cavity.hpp>
+#include <lyrahgames/delaunay/connectivity.hpp>
+#include <lyrahgames/delaunay/slot_pool.hpp>
+#include <lyrahgames/delaunay/statistics.hpp>
+#include <lyrahgames/delaunay/type_traits.hpp>
 
 namespace lyrahgames::delaunay {
 
 namespace detail {
 
-template <typename F, typename... Args,
-          typename = decltype(std::declval<F>()(std::declval<Args&&>()...))>
-std::true_type is_valid_implementation(void*);
-
-template <typename F, typename... Args>
-std::false_type is_valid_implementation(...);
-
-constexpr auto is_valid = [](auto f) constexpr {
-  return [](auto&&... args) constexpr {
-    return decltype(
-        is_valid_implementation<decltype(f), decltype(args)&&...>(nullptr)){};
-  };
-};
-
-constexpr auto has_public_xy = is_valid([](auto&& v) -> decltype(v.x * v.y) {});
+constexpr auto has_public_xy =
+    delaunay::is_valid([](auto&& v) -> decltype(v.x * v.y) {});
 
 constexpr auto has_function_xy =
-    is_valid([](auto&& v) -> decltype(v.x() * v.y()) {});
+    delaunay::is_valid([](auto&& v) -> decltype(v.x() * v.y()) {});
 
 constexpr auto has_accesss_operator =
-    is_valid([](auto&& v) -> decltype(v[0] * v[1]) {});
+    delaunay::is_valid([](auto&& v) -> decltype(v[0] * v[1]) {});
+
+// Sorts the facets of all removed simplices and calls f for every facet
+// that occurs exactly once. These facets bound the cavity. The vector
+// keeps its capacity and so the polytope does not allocate after warm-up.
+template <typename Facets, typename Functor>
+void for_each_boundary_facet(Facets& facets, Functor&& f) {
+  std::sort(facets.begin(), facets.end());
+  for (size_t i = 0; i < facets.size();) {
+    auto j = i + 1;
+    while ((j < facets.size()) && (facets[j] == facets[i])) ++j;
+    if (j == i + 1) f(facets[i]);
+    i = j;
+  }
+}
 
 }  // namespace detail
 
@@ -142,8 +151,13 @@ struct simplex : public std::array<size_t, 3> {
   }
 };
 
-template <typename Point>
-std::vector<simplex> triangulation(std::vector<Point>& points) {
+// If the connectivity is requested, the neighbors of all simplices and
+// the simplices around each vertex will be filled during the final pass.
+// All containers, including the result, use the given allocator template.
+template <template <typename> typename Allocator = std::allocator,
+          typename Point>
+std::vector<simplex, Allocator<simplex>> triangulation(
+    std::vector<Point>& points, connectivity<3>* adjacency = nullptr) {
   // Construct much larger bounding box for all points.
   const Point bounds[4] = {
       {-1.0e6f, -1.0e6f},
@@ -151,16 +165,16 @@ std::vector<simplex> triangulation(std::vector<Point>& points) {
       {1.0e6f, 1.0e6f},
       {-1.0e6f, 1.0e6f},
   };
-  std::unordered_set<simplex, simplex::hash> simplices{
-      {reinterpret_cast<size_t>(&bounds[0]),  //
-       reinterpret_cast<size_t>(&bounds[1]),  //
-       reinterpret_cast<size_t>(&bounds[2])},
-      {reinterpret_cast<size_t>(&bounds[2]),  //
-       reinterpret_cast<size_t>(&bounds[3]),  //
-       reinterpret_cast<size_t>(&bounds[0])}};
+  slot_pool<simplex, Allocator> simplices{};
+  simplices.reserve(2 * points.size() + 2);
+  simplices.insert({reinterpret_cast<size_t>(&bounds[0]),  //
+                    reinterpret_cast<size_t>(&bounds[1]),  //
+                    reinterpret_cast<size_t>(&bounds[2])});
+  simplices.insert({reinterpret_cast<size_t>(&bounds[2]),  //
+                    reinterpret_cast<size_t>(&bounds[3]),  //
+                    reinterpret_cast<size_t>(&bounds[0])});
 
-  // std::unordered_map<facet, int, facet::hash> polytope{};
-  std::map<facet, int> polytope{};
+  std::vector<facet, Allocator<facet>> polytope{};
 
   // Incrementally insert every point.
   for (const auto& p : points) {
@@ -168,31 +182,34 @@ std::vector<simplex> triangulation(std::vector<Point>& points) {
     // according to Bowyer and Watson.
     polytope.clear();
     // Test for the circumcircle intersection with every polytope.
-    for (auto it = simplices.begin(); it != simplices.end();) {
-      auto& t = *it;
+    for (size_t i = 0; i < simplices.slot_count(); ++i) {
+      if (!simplices.alive(i)) continue;
+      const auto& t = simplices[i];
       if (circumcircle_intersection(reinterpret_cast<const Point*>(t[0]),
                                     reinterpret_cast<const Point*>(t[1]),
                                     reinterpret_cast<const Point*>(t[2]), &p)) {
         // If so, simplex has to be removed and added to the polytope.
-        ++polytope[{t[0], t[1]}];
-        ++polytope[{t[1], t[2]}];
-        ++polytope[{t[2], t[0]}];
-        it = simplices.erase(it);
-      } else {
-        ++it;
+        polytope.push_back({t[0], t[1]});
+        polytope.push_back({t[1], t[2]});
+        polytope.push_back({t[2], t[0]});
+        simplices.erase(i);
       }
     }
     // Add new simplices by connecting boundary facets
     // of the polytope with the new point.
-    for (auto& [e, i] : polytope)
-      if (i == 1) simplices.insert({e[0], e[1], reinterpret_cast<size_t>(&p)});
+    detail::for_each_boundary_facet(polytope, [&](const facet& e) {
+      simplices.insert({e[0], e[1], reinterpret_cast<size_t>(&p)});
+    });
   }
 
   // Construct the result vector by adding all simplices
   // not referencing points of the bounding box.
-  std::vector<simplex> result{};
+  std::vector<simplex, Allocator<simplex>> result{};
   result.reserve(simplices.size());
-  for (const auto& t : simplices) {
+  if (adjacency) adjacency->reset(points.size());
+  for (size_t i = 0; i < simplices.slot_count(); ++i) {
+    if (!simplices.alive(i)) continue;
+    const auto& t = simplices[i];
     const auto a =
         static_cast<size_t>(reinterpret_cast<const Point*>(t[0]) - &points[0]);
     const auto b =
@@ -200,9 +217,12 @@ std::vector<simplex> triangulation(std::vector<Point>& points) {
     const auto c =
         static_cast<size_t>(reinterpret_cast<const Point*>(t[2]) - &points[0]);
 
-    if ((a < points.size()) && (b < points.size()) && (c < points.size()))
+    if ((a < points.size()) && (b < points.size()) && (c < points.size())) {
       result.emplace_back(a, b, c);
+      if (adjacency) adjacency->count(result.back());
+    }
   }
+  if (adjacency) adjacency->assemble(result);
 
   return result;
 }
@@ -233,7 +253,9 @@ constexpr auto intersection(const circle& c, const point* p) noexcept {
   return (r.x * r.x + r.y * r.y) <= c.r2;
 };
 
-std::vector<simplex> triangulation(std::vector<point>& points) {
+template <template <typename> typename Allocator = std::allocator>
+std::vector<simplex, Allocator<simplex>> triangulation(
+    std::vector<point>& points, connectivity<3>* adjacency = nullptr) {
   // Construct much larger bounding box for all points.
   const point bounds[4] = {
       {-1.0e3f, -1.0e3f},
@@ -241,20 +263,18 @@ std::vector<simplex> triangulation(std::vector<point>& points) {
       {1.0e3f, 1.0e3f},
       {-1.0e3f, 1.0e3f},
   };
-  std::unordered_map<simplex, circle, simplex::hash> simplices{
-      std::pair<simplex, circle>{
-          {reinterpret_cast<size_t>(&bounds[0]),  //
-           reinterpret_cast<size_t>(&bounds[1]),  //
-           reinterpret_cast<size_t>(&bounds[2])},
-          circumcircle(&bounds[0], &bounds[1], &bounds[2])},
-      std::pair<simplex, circle>{
-          {reinterpret_cast<size_t>(&bounds[2]),  //
-           reinterpret_cast<size_t>(&bounds[3]),  //
-           reinterpret_cast<size_t>(&bounds[0])},
-          circumcircle(&bounds[2], &bounds[3], &bounds[0])}};
-
-  std::unordered_map<facet, int, facet::hash> polytope{};
-  // std::map<facet, int> polytope{};
+  slot_pool<std::pair<simplex, circle>, Allocator> simplices{};
+  simplices.reserve(2 * points.size() + 2);
+  simplices.insert({{reinterpret_cast<size_t>(&bounds[0]),  //
+                     reinterpret_cast<size_t>(&bounds[1]),  //
+                     reinterpret_cast<size_t>(&bounds[2])},
+                    circumcircle(&bounds[0], &bounds[1], &bounds[2])});
+  simplices.insert({{reinterpret_cast<size_t>(&bounds[2]),  //
+                     reinterpret_cast<size_t>(&bounds[3]),  //
+                     reinterpret_cast<size_t>(&bounds[0])},
+                    circumcircle(&bounds[2], &bounds[3], &bounds[0])});
+
+  std::vector<facet, Allocator<facet>> polytope{};
 
   // Incrementally insert every point.
   for (const auto& p : points) {
@@ -262,35 +282,34 @@ std::vector<simplex> triangulation(std::vector<point>& points) {
     // according to Bowyer and Watson.
     polytope.clear();
     // Test for the circumcircle intersection with every polytope.
-    for (auto it = simplices.begin(); it != simplices.end();) {
-      auto& t = it->first;
-      if (intersection(it->second, &p)) {
+    for (size_t i = 0; i < simplices.slot_count(); ++i) {
+      if (!simplices.alive(i)) continue;
+      const auto& [t, c] = simplices[i];
+      if (intersection(c, &p)) {
         // If so, simplex has to be removed and added to the polytope.
-        ++polytope[{t[0], t[1]}];
-        ++polytope[{t[1], t[2]}];
-        ++polytope[{t[2], t[0]}];
-        it = simplices.erase(it);
-      } else {
-        ++it;
+        polytope.push_back({t[0], t[1]});
+        polytope.push_back({t[1], t[2]});
+        polytope.push_back({t[2], t[0]});
+        simplices.erase(i);
       }
     }
     // Add new simplices by connecting boundary facets
     // of the polytope with the new point.
-    for (auto& [e, i] : polytope) {
-      if (i == 1) {
-        const auto c = circumcircle(reinterpret_cast<const point*>(e[0]),
-                                    reinterpret_cast<const point*>(e[1]), &p);
-        // std::cout << c.c.x << ' ' << c.c.y << ' ' << c.r2 << std::endl;
-        simplices.insert({{e[0], e[1], reinterpret_cast<size_t>(&p)}, c});
-      }
-    }
+    detail::for_each_boundary_facet(polytope, [&](const facet& e) {
+      const auto c = circumcircle(reinterpret_cast<const point*>(e[0]),
+                                  reinterpret_cast<const point*>(e[1]), &p);
+      simplices.insert({{e[0], e[1], reinterpret_cast<size_t>(&p)}, c});
+    });
   }
 
   // Construct the result vector by adding all simplices
   // not referencing points of the bounding box.
-  std::vector<simplex> result{};
+  std::vector<simplex, Allocator<simplex>> result{};
   result.reserve(simplices.size());
-  for (const auto& [t, _] : simplices) {
+  if (adjacency) adjacency->reset(points.size());
+  for (size_t i = 0; i < simplices.slot_count(); ++i) {
+    if (!simplices.alive(i)) continue;
+    const auto& t = simplices[i].first;
     const auto a =
         static_cast<size_t>(reinterpret_cast<const point*>(t[0]) - &points[0]);
     const auto b =
@@ -298,9 +317,12 @@ std::vector<simplex> triangulation(std::vector<point>& points) {
     const auto c =
         static_cast<size_t>(reinterpret_cast<const point*>(t[2]) - &points[0]);
 
-    if ((a < points.size()) && (b < points.size()) && (c < points.size()))
+    if ((a < points.size()) && (b < points.size()) && (c < points.size())) {
       result.emplace_back(a, b, c);
+      if (adjacency) adjacency->count(result.back());
+    }
   }
+  if (adjacency) adjacency->assemble(result);
 
   return result;
 }
@@ -373,6 +395,78 @@ constexpr auto intersection(const sphere& s, const point& p) noexcept {
   return sqnorm(p - s.c) <= s.r2;
 };
 
+// Positive if p lies inside the circumsphere
+// of the positively oriented tetrahedron (a, b, c, d).
+// The determinant is evaluated in double precision. It is not exact,
+// but its rounding errors are far smaller than the ones of float spheres.
+inline double insphere(const point& a, const point& b, const point& c,
+                       const point& d, const point& p) noexcept {
+  const auto lift = [&p](const point& x) {
+    const double dx = double(x.x) - p.x, dy = double(x.y) - p.y,
+                 dz = double(x.z) - p.z;
+    return std::array<double, 4>{dx, dy, dz, dx * dx + dy * dy + dz * dz};
+  };
+  const auto [ax, ay, az, al] = lift(a);
+  const auto [bx, by, bz, bl] = lift(b);
+  const auto [cx, cy, cz, cl] = lift(c);
+  const auto [dx, dy, dz, dl] = lift(d);
+  const auto ab = ax * by - bx * ay;
+  const auto bc = bx * cy - cx * by;
+  const auto cd = cx * dy - dx * cy;
+  const auto da = dx * ay - ax * dy;
+  const auto ac = ax * cy - cx * ay;
+  const auto bd = bx * dy - dx * by;
+  const auto abc = az * bc - bz * ac + cz * ab;
+  const auto bcd = bz * cd - cz * bd + dz * bc;
+  const auto cda = cz * da + dz * ac + az * cd;
+  const auto dab = dz * ab + az * bd + bz * da;
+  return (al * bcd - bl * cda) + (cl * dab - dl * abc);
+}
+
+inline sphere precise_circumsphere(const point& a, const point& b,
+                                   const point& c, const point& d) noexcept {
+  const double u[3] = {double(b.x) - a.x, double(b.y) - a.y,
+                       double(b.z) - a.z};
+  const double v[3] = {double(c.x) - a.x, double(c.y) - a.y,
+                       double(c.z) - a.z};
+  const double w[3] = {double(d.x) - a.x, double(d.y) - a.y,
+                       double(d.z) - a.z};
+  const auto cross = [](const double* x, const double* y) {
+    return std::array<double, 3>{x[1] * y[2] - x[2] * y[1],
+                                 x[2] * y[0] - x[0] * y[2],
+                                 x[0] * y[1] - x[1] * y[0]};
+  };
+  const auto sqnorm = [](const double* x) {
+    return x[0] * x[0] + x[1] * x[1] + x[2] * x[2];
+  };
+  const auto vw = cross(v, w);
+  const auto wu = cross(w, u);
+  const auto uv = cross(u, v);
+  const auto det = 2 * (u[0] * vw[0] + u[1] * vw[1] + u[2] * vw[2]);
+  const auto su = sqnorm(u) / det;
+  const auto sv = sqnorm(v) / det;
+  const auto sw = sqnorm(w) / det;
+  double m[3];
+  for (int i = 0; i < 3; ++i) m[i] = su * vw[i] + sv * wu[i] + sw * uv[i];
+  return sphere{{float(a.x + m[0]), float(a.y + m[1]), float(a.z + m[2])},
+                float(sqnorm(m))};
+}
+
+// Tests if p lies inside the circumsphere s of the positively oriented
+// tetrahedron (a, b, c, d). The sphere decides unless the point is too
+// close to its surface with respect to a heuristic bound on the rounding
+// errors of the float computation. Then, the double precision determinant
+// is evaluated instead.
+inline bool intersection(const sphere& s, const point& a, const point& b,
+                         const point& c, const point& d,
+                         const point& p) noexcept {
+  const auto distance = sqnorm(p - s.c) - s.r2;
+  const auto tolerance = 1e-6f * (s.r2 + 2 * (sqnorm(p) + sqnorm(s.c)));
+  if (distance < -tolerance) return true;
+  if (distance > tolerance) return false;
+  return insphere(a, b, c, d, p) > 0;
+}
+
 struct face : public std::array<size_t, 3> {
   using base_type = std::array<size_t, 3>;
 
@@ -429,19 +523,30 @@ constexpr std::array<point, 4> bounding_tetrahedron(const sphere& s) noexcept {
   return {k * a + s.c, k * b + s.c, k * c + s.c, k * d + s.c};
 }
 
-std::vector<tetrahedron> triangulation(const std::vector<point>& points) {
+// If the connectivity is requested, the neighbors of all tetrahedra and
+// the tetrahedra around each vertex will be filled during the final pass.
+// If the hull is requested, the faces of all tetrahedra adjacent to exactly
+// one vertex of the super tetrahedron are collected in the same pass.
+// They are oriented counterclockwise when seen from the outside.
+// Events of the construction are reported to the statistics policy.
+// All containers, including the result, use the given allocator template.
+template <template <typename> typename Allocator = std::allocator,
+          typename Statistics = no_statistics>
+std::vector<tetrahedron, Allocator<tetrahedron>> triangulation(
+    const std::vector<point>& points, connectivity<4>* adjacency = nullptr,
+    std::vector<std::array<size_t, 3>>* hull = nullptr,
+    Statistics&& statistics = {}) {
   // Construct regular super tetrahedron which contains all given points.
   const auto box = aabb(points);
   const auto bound_sphere = bounding_sphere(box);
   const auto bounds =
       bounding_tetrahedron({bound_sphere.c, 100 * bound_sphere.r2});
-  std::unordered_map<tetrahedron, sphere, tetrahedron::hash> simplices{
-      std::pair<tetrahedron, sphere>{
-          {reinterpret_cast<size_t>(&bounds[0]),  //
-           reinterpret_cast<size_t>(&bounds[1]),  //
-           reinterpret_cast<size_t>(&bounds[2]),  //
-           reinterpret_cast<size_t>(&bounds[3])},
-          circumsphere(bounds[0], bounds[1], bounds[2], bounds[3])}};
+  slot_pool<std::pair<tetrahedron, sphere>, Allocator> simplices{};
+  simplices.insert({{reinterpret_cast<size_t>(&bounds[0]),  //
+                     reinterpret_cast<size_t>(&bounds[1]),  //
+                     reinterpret_cast<size_t>(&bounds[2]),  //
+                     reinterpret_cast<size_t>(&bounds[3])},
+                    circumsphere(bounds[0], bounds[1], bounds[2], bounds[3])});
 
   // Construct much larger bounding box for all points.
   // constexpr float big_num = 1.0e3f;
@@ -484,45 +589,50 @@ std::vector<tetrahedron> triangulation(const std::vector<point>& points) {
   //         circumsphere(bounds[3], bounds[4], bounds[5], bounds[7])},
   // };
 
-  std::unordered_map<face, int, face::hash> polytope{};
+  std::vector<face, Allocator<face>> polytope{};
 
   // Incrementally insert every point.
   for (const auto& p : points) {
     // Construct the polytope for a new polytope
     // according to Bowyer and Watson.
     polytope.clear();
+    statistics.insert();
+    statistics.test_incircle(simplices.size());
+    const auto old_size = simplices.size();
     // Test for the circumcircle intersection with every polytope.
-    for (auto it = simplices.begin(); it != simplices.end();) {
-      auto& t = it->first;
-      if (intersection(it->second, p)) {
+    for (size_t i = 0; i < simplices.slot_count(); ++i) {
+      if (!simplices.alive(i)) continue;
+      const auto& [t, s] = simplices[i];
+      if (intersection(s, p)) {
         // If so, tetrahedron has to be removed and added to the polytope.
-        ++polytope[{t[0], t[1], t[2]}];
-        ++polytope[{t[1], t[2], t[3]}];
-        ++polytope[{t[2], t[3], t[0]}];
-        ++polytope[{t[3], t[0], t[1]}];
-        it = simplices.erase(it);
-      } else {
-        ++it;
+        polytope.push_back({t[0], t[1], t[2]});
+        polytope.push_back({t[1], t[2], t[3]});
+        polytope.push_back({t[2], t[3], t[0]});
+        polytope.push_back({t[3], t[0], t[1]});
+        simplices.erase(i);
       }
     }
+    const auto remaining = simplices.size();
     // Add new simplices by connecting boundary facets
     // of the polytope with the new point.
-    for (auto& [e, i] : polytope) {
-      if (i == 1) {
-        const auto c = circumsphere(*reinterpret_cast<const point*>(e[0]),
-                                    *reinterpret_cast<const point*>(e[1]),
-                                    *reinterpret_cast<const point*>(e[2]), p);
-        // std::cout << c.c.x << ' ' << c.c.y << ' ' << c.r2 << std::endl;
-        simplices.insert({{e[0], e[1], e[2], reinterpret_cast<size_t>(&p)}, c});
-      }
-    }
+    detail::for_each_boundary_facet(polytope, [&](const face& e) {
+      const auto c = circumsphere(*reinterpret_cast<const point*>(e[0]),
+                                  *reinterpret_cast<const point*>(e[1]),
+                                  *reinterpret_cast<const point*>(e[2]), p);
+      simplices.insert({{e[0], e[1], e[2], reinterpret_cast<size_t>(&p)}, c});
+    });
+    statistics.cavity(old_size - remaining, simplices.size() - remaining);
   }
 
   // Construct the result vector by adding all simplices
   // not referencing points of the bounding box.
-  std::vector<tetrahedron> result{};
+  std::vector<tetrahedron, Allocator<tetrahedron>> result{};
   result.reserve(simplices.size());
-  for (const auto& [t, _] : simplices) {
+  if (adjacency) adjacency->reset(points.size());
+  if (hull) hull->clear();
+  for (size_t i = 0; i < simplices.slot_count(); ++i) {
+    if (!simplices.alive(i)) continue;
+    const auto& t = simplices[i].first;
     const auto a =
         static_cast<size_t>(reinterpret_cast<const point*>(t[0]) - &points[0]);
     const auto b =
@@ -533,13 +643,218 @@ std::vector<tetrahedron> triangulation(const std::vector<point>& points) {
         static_cast<size_t>(reinterpret_cast<const point*>(t[3]) - &points[0]);
 
     if ((a < points.size()) && (b < points.size()) && (c < points.size()) &&
-        (d < points.size()))
+        (d < points.size())) {
       result.emplace_back(a, b, c, d);
+      if (adjacency) adjacency->count(result.back());
+      continue;
+    }
+
+    if (!hull) continue;
+    const size_t v[4] = {a, b, c, d};
+    size_t outer = 4;
+    size_t count = 0;
+    for (size_t k = 0; k < 4; ++k) {
+      if (v[k] < points.size()) continue;
+      outer = k;
+      ++count;
+    }
+    if (count != 1) continue;
+    std::array<size_t, 3> f{v[(outer + 1) % 4], v[(outer + 2) % 4],
+                            v[(outer + 3) % 4]};
+    // Let the normal point to the super vertex.
+    const auto& s = *reinterpret_cast<const point*>(t[outer]);
+    if (dot(cross(points[f[1]] - points[f[0]], points[f[2]] - points[f[0]]),
+            s - points[f[0]]) < 0)
+      std::swap(f[1], f[2]);
+    hull->push_back(f);
   }
+  if (adjacency) adjacency->assemble(result);
 
   return result;
 }
 
+
+namespace ghost {
+
+// Instead of a numeric super tetrahedron, this triangulation connects every
+// face of the convex hull to a symbolic vertex at infinity.
+// The resulting ghost tetrahedra are stored separately as oriented hull faces
+// whose positive side is the exterior. A point is in conflict with a ghost
+// tetrahedron if it lies strictly on the positive side of its face or
+// inside the circumcircle of the face itself. As a consequence,
+// the predicates never see artificial coordinates and the real tetrahedra
+// can be returned without filtering.
+// Real tetrahedra (a, b, c, d) are positively oriented which means
+// that d lies on the positive side of the face (a, b, c).
+
+constexpr size_t infinity = std::numeric_limits<size_t>::max();
+
+constexpr auto orientation(const point& a, const point& b, const point& c,
+                           const point& d) noexcept {
+  return dot(cross(b - a, c - a), d - a);
+}
+
+constexpr auto circumcircle_intersection(const point& a, const point& b,
+                                         const point& c,
+                                         const point& p) noexcept {
+  const auto u = b - a;
+  const auto v = c - a;
+  const auto w = cross(u, v);
+  const auto m = (1.0f / (2.0f * sqnorm(w))) *
+                 (sqnorm(u) * cross(v, w) + sqnorm(v) * cross(w, u));
+  return sqnorm(p - a - m) < sqnorm(m);
+}
+
+inline bool ghost_conflict(const point& a, const point& b, const point& c,
+                           const point& p) noexcept {
+  const auto o = orientation(a, b, c, p);
+  if (o > 0) return true;
+  if (o < 0) return false;
+  return circumcircle_intersection(a, b, c, p);
+}
+
+template <template <typename> typename Allocator = std::allocator,
+          typename Statistics = no_statistics>
+std::vector<tetrahedron, Allocator<tetrahedron>> triangulation(
+    const std::vector<point>& points, connectivity<4>* adjacency = nullptr,
+    Statistics&& statistics = {}) {
+  using hull_face = std::array<size_t, 3>;
+  std::vector<tetrahedron, Allocator<tetrahedron>> result{};
+  if (adjacency) adjacency->reset(points.size());
+
+  // Find the first four points that are not coplanar.
+  const auto n = points.size();
+  const auto equal = [](const point& x, const point& y) {
+    return (x.x == y.x) && (x.y == y.y) && (x.z == y.z);
+  };
+  size_t seed[4] = {0, 1, 0, 0};
+  while ((seed[1] < n) && equal(points[0], points[seed[1]])) ++seed[1];
+  if (seed[1] >= n) return result;
+  seed[2] = seed[1] + 1;
+  while ((seed[2] < n) && (sqnorm(cross(points[seed[1]] - points[0],
+                                        points[seed[2]] - points[0])) == 0))
+    ++seed[2];
+  if (seed[2] >= n) return result;
+  seed[3] = seed[2] + 1;
+  while ((seed[3] < n) && (orientation(points[0], points[seed[1]],
+                                       points[seed[2]], points[seed[3]]) == 0))
+    ++seed[3];
+  if (seed[3] >= n) return result;
+  if (orientation(points[0], points[seed[1]], points[seed[2]],
+                  points[seed[3]]) < 0)
+    std::swap(seed[1], seed[2]);
+
+  struct element {
+    std::array<size_t, 4> v;
+    sphere s;
+  };
+  const auto make_element = [&points](size_t a, size_t b, size_t c,
+                                      size_t d) {
+    return element{{a, b, c, d}, precise_circumsphere(points[a], points[b],
+                                                      points[c], points[d])};
+  };
+  std::vector<element, Allocator<element>> tetrahedra{
+      make_element(seed[0], seed[1], seed[2], seed[3])};
+  // The faces of a positively oriented tetrahedron (a, b, c, d) whose
+  // positive side is the interior are (a, b, c), (b, d, c), (a, c, d),
+  // and (a, d, b). Ghosts are given by their reversed orientation.
+  const auto [a, b, c, d] = tetrahedra[0].v;
+  std::vector<hull_face, Allocator<hull_face>> ghosts{
+      {a, c, b}, {b, c, d}, {a, d, c}, {a, b, d}};
+
+  // The polytope stores every face of the cavity together with
+  // its orientation in the removed element that inserted it last.
+  struct oriented_face {
+    std::array<size_t, 3> v;
+    int count = 0;
+  };
+  std::unordered_map<face, oriented_face, face::hash, std::equal_to<face>,
+                     Allocator<std::pair<const face, oriented_face>>>
+      polytope{};
+  const auto add_face = [&polytope](size_t a, size_t b, size_t c) {
+    auto& f = polytope[{a, b, c}];
+    f.v = {a, b, c};
+    ++f.count;
+  };
+  std::vector<size_t, Allocator<size_t>> bad_tetrahedra{};
+  std::vector<size_t, Allocator<size_t>> bad_ghosts{};
+  std::vector<element, Allocator<element>> new_tetrahedra{};
+  std::vector<hull_face, Allocator<hull_face>> new_ghosts{};
+
+  for (size_t pid = 1; pid < n; ++pid) {
+    if ((pid == seed[1]) || (pid == seed[2]) || (pid == seed[3])) continue;
+    const auto& p = points[pid];
+
+    polytope.clear();
+    bad_tetrahedra.clear();
+    bad_ghosts.clear();
+
+    // A duplicated point may only be reported to be in conflict with
+    // tetrahedra it is a vertex of. It will not be inserted.
+    bool duplicate = false;
+    for (size_t i = 0; i < tetrahedra.size(); ++i) {
+      const auto [a, b, c, d] = tetrahedra[i].v;
+      if (!intersection(tetrahedra[i].s, points[a], points[b], points[c],
+                        points[d], p))
+        continue;
+      duplicate |= equal(points[a], p) || equal(points[b], p) ||
+                   equal(points[c], p) || equal(points[d], p);
+      bad_tetrahedra.push_back(i);
+      add_face(a, b, c);
+      add_face(b, d, c);
+      add_face(a, c, d);
+      add_face(a, d, b);
+    }
+    for (size_t i = 0; i < ghosts.size(); ++i) {
+      const auto [a, b, c] = ghosts[i];
+      if (!ghost_conflict(points[a], points[b], points[c], p)) continue;
+      bad_ghosts.push_back(i);
+      add_face(a, b, c);
+      add_face(b, infinity, c);
+      add_face(a, c, infinity);
+      add_face(a, infinity, b);
+    }
+    statistics.test_incircle(tetrahedra.size());
+    statistics.test_orientation(ghosts.size());
+    if (duplicate || (bad_tetrahedra.empty() && bad_ghosts.empty())) {
+      statistics.skip_duplicate();
+      continue;
+    }
+    statistics.insert();
+
+    // Connect every oriented boundary face of the cavity to the new point.
+    // A face (u, infinity, w) becomes the ghost (p, u, w).
+    new_tetrahedra.clear();
+    new_ghosts.clear();
+    for (const auto& [_, f] : polytope) {
+      if (f.count != 1) continue;
+      const auto [a, b, c] = f.v;
+      if (a == infinity)
+        new_ghosts.push_back({pid, c, b});
+      else if (b == infinity)
+        new_ghosts.push_back({pid, a, c});
+      else if (c == infinity)
+        new_ghosts.push_back({pid, b, a});
+      else
+        new_tetrahedra.push_back(make_element(a, b, c, pid));
+    }
+    statistics.cavity(bad_tetrahedra.size() + bad_ghosts.size(),
+                      new_tetrahedra.size() + new_ghosts.size());
+    delaunay::detail::replace(tetrahedra, bad_tetrahedra, new_tetrahedra);
+    delaunay::detail::replace(ghosts, bad_ghosts, new_ghosts);
+  }
+
+  result.reserve(tetrahedra.size());
+  for (const auto& t : tetrahedra) {
+    result.emplace_back(t.v[0], t.v[1], t.v[2], t.v[3]);
+    if (adjacency) adjacency->count(result.back());
+  }
+  if (adjacency) adjacency->assemble(result);
+  return result;
+}
+
+}  // namespace ghost
+
 }  // namespace experimental_3d
 
 }  // namespace lyrahgames::delaunay
\ No newline at end of file
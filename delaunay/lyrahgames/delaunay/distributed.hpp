@@ -0,0 +1,637 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+//
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define LYRAHGAMES_DELAUNAY_SOCKETS 1
+#endif
+//
+#include <lyrahgames/delaunay/geometry.hpp>
+#include <lyrahgames/delaunay/guibas_stolfi.hpp>
+
+namespace lyrahgames::delaunay::distributed {
+
+// Distributed triangulation over several processes, called ranks.
+// Every rank calls 'triangulation' with its own part of the input and
+// a transport connecting it to all other ranks. The transport is
+// a template parameter providing the following members.
+//
+//   size_t rank() const;
+//   size_t size() const;
+//   void send(size_t to, std::vector<std::byte> message);
+//   std::vector<std::byte> receive(size_t from);
+//
+// Messages between two ranks have to arrive in the order they were sent.
+// Sending must not block until the message has been received.
+
+using point = guibas_stolfi::point;
+using triangle = std::array<size_t, 3>;
+using message = std::vector<std::byte>;
+
+// Transport between threads of the same process.
+// It stands in for real processes in tests and on a single machine.
+class local_transport {
+ public:
+  // Creates connected transports for the given number of ranks.
+  static std::vector<local_transport> create(size_t size) {
+    const auto shared = std::make_shared<network>();
+    shared->count = size;
+    shared->queues.resize(size * size);
+    std::vector<local_transport> result{};
+    for (size_t r = 0; r < size; ++r) result.push_back({shared, r});
+    return result;
+  }
+
+  size_t rank() const noexcept { return id; }
+  size_t size() const noexcept { return shared->count; }
+
+  void send(size_t to, message m) {
+    {
+      std::scoped_lock lock{shared->mutex};
+      shared->queues[id * size() + to].push_back(std::move(m));
+    }
+    shared->ready.notify_all();
+  }
+
+  message receive(size_t from) {
+    std::unique_lock lock{shared->mutex};
+    auto& queue = shared->queues[from * size() + id];
+    shared->ready.wait(lock, [&queue] { return !queue.empty(); });
+    auto result = std::move(queue.front());
+    queue.pop_front();
+    return result;
+  }
+
+ private:
+  struct network {
+    std::mutex mutex;
+    std::condition_variable ready;
+    // Queue of messages from rank i to rank j at index i * count + j.
+    std::vector<std::deque<message>> queues;
+    size_t count;
+  };
+
+  local_transport(std::shared_ptr<network> n, size_t r)
+      : shared{std::move(n)}, id{r} {}
+
+  std::shared_ptr<network> shared;
+  size_t id;
+};
+
+#ifdef LYRAHGAMES_DELAUNAY_SOCKETS
+
+// Transport between processes on the same machine based on pairs of
+// connected Unix domain sockets. All transports are created by one process
+// before forking the ranks. Every rank then moves its own transport out of
+// the returned vector and destroys the others to close their sockets.
+// Messages are prefixed by their size. The sockets are non-blocking and,
+// while sending, incoming data of all ranks is buffered such that
+// two ranks sending large messages to each other cannot deadlock.
+class socket_transport {
+ public:
+  static std::vector<socket_transport> create(size_t size) {
+    std::vector<socket_transport> result(size);
+    for (size_t r = 0; r < size; ++r) {
+      result[r].id = r;
+      result[r].sockets.assign(size, -1);
+      result[r].inbox.resize(size);
+    }
+    for (size_t i = 0; i < size; ++i) {
+      for (size_t j = i + 1; j < size; ++j) {
+        int pair[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0)
+          throw std::runtime_error("Failed to create socket pair.");
+        for (auto fd : pair) ::fcntl(fd, F_SETFL, O_NONBLOCK);
+        result[i].sockets[j] = pair[0];
+        result[j].sockets[i] = pair[1];
+      }
+    }
+    return result;
+  }
+
+  socket_transport() = default;
+  socket_transport(socket_transport&& other) noexcept { swap(other); }
+  socket_transport& operator=(socket_transport&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~socket_transport() {
+    for (auto fd : sockets)
+      if (fd >= 0) ::close(fd);
+  }
+
+  size_t rank() const noexcept { return id; }
+  size_t size() const noexcept { return sockets.size(); }
+
+  void send(size_t to, message m) {
+    const uint64_t length = m.size();
+    message frame(sizeof(length));
+    std::memcpy(frame.data(), &length, sizeof(length));
+    frame.insert(frame.end(), m.begin(), m.end());
+    size_t written = 0;
+    while (written < frame.size()) {
+      if (sockets[to] < 0)
+        throw std::runtime_error("Connection closed by other rank.");
+      poll(to);
+      const auto n = ::write(sockets[to], frame.data() + written,
+                             frame.size() - written);
+      if (n > 0)
+        written += n;
+      else if ((n < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK))
+        throw std::runtime_error("Failed to send message.");
+    }
+  }
+
+  message receive(size_t from) {
+    auto& buffer = inbox[from];
+    uint64_t length = 0;
+    while (true) {
+      if (buffer.size() >= sizeof(length)) {
+        std::memcpy(&length, buffer.data(), sizeof(length));
+        if (buffer.size() >= sizeof(length) + length) break;
+      }
+      if (sockets[from] < 0)
+        throw std::runtime_error("Connection closed by other rank.");
+      poll(size());
+    }
+    const auto first = buffer.begin() + sizeof(length);
+    message result(first, first + length);
+    buffer.erase(buffer.begin(), first + length);
+    return result;
+  }
+
+ private:
+  void swap(socket_transport& other) noexcept {
+    std::swap(id, other.id);
+    std::swap(sockets, other.sockets);
+    std::swap(inbox, other.inbox);
+  }
+
+  // Waits until some socket can be read or the socket of the given
+  // rank can be written and buffers all incoming data.
+  void poll(size_t writer) {
+    std::vector<pollfd> fds(size());
+    for (size_t r = 0; r < size(); ++r) {
+      fds[r].fd = sockets[r];
+      fds[r].events = POLLIN | ((r == writer) ? POLLOUT : 0);
+    }
+    if (::poll(fds.data(), fds.size(), -1) < 0)
+      throw std::runtime_error("Failed to poll sockets.");
+    std::byte chunk[1 << 16];
+    for (size_t r = 0; r < size(); ++r) {
+      if (!(fds[r].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+      const auto n = ::read(sockets[r], chunk, sizeof(chunk));
+      if (n > 0) {
+        inbox[r].insert(inbox[r].end(), chunk, chunk + n);
+      } else if (n == 0) {
+        // Ranks that are done close their sockets. Polling ignores them.
+        ::close(sockets[r]);
+        sockets[r] = -1;
+      } else if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+        throw std::runtime_error("Failed to receive message.");
+      }
+    }
+  }
+
+  size_t id{};
+  // Socket connected to every other rank and -1 for the rank itself.
+  std::vector<int> sockets{};
+  // Received but not yet consumed bytes of every other rank.
+  std::vector<message> inbox{};
+};
+
+#endif
+
+namespace detail {
+
+template <typename T>
+void append(message& m, const T* data, size_t n) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  const auto offset = m.size();
+  m.resize(offset + n * sizeof(T));
+  if (n) std::memcpy(m.data() + offset, data, n * sizeof(T));
+}
+
+template <typename T>
+void append(message& m, const T& value) {
+  append(m, &value, 1);
+}
+
+// Sequential reader for the values written by 'append'.
+struct reader {
+  template <typename T>
+  void read(T* data, size_t n) {
+    if (n) std::memcpy(data, m.data() + offset, n * sizeof(T));
+    offset += n * sizeof(T);
+  }
+
+  template <typename T>
+  T read() {
+    T value;
+    read(&value, 1);
+    return value;
+  }
+
+  bool done() const noexcept { return offset >= m.size(); }
+
+  const message& m;
+  size_t offset = 0;
+};
+
+// Sends one message to every rank and returns the messages from every rank.
+// The message of a rank to itself is passed through.
+template <typename Transport>
+auto exchange(Transport& transport, std::vector<message> outgoing) {
+  const auto rank = transport.rank();
+  std::vector<message> result(transport.size());
+  for (size_t r = 0; r < transport.size(); ++r)
+    if (r != rank) transport.send(r, std::move(outgoing[r]));
+  for (size_t r = 0; r < transport.size(); ++r)
+    result[r] = (r == rank) ? std::move(outgoing[r]) : transport.receive(r);
+  return result;
+}
+
+// Point together with its global index.
+struct indexed_point {
+  size_t index;
+  point position;
+};
+
+using real2 = std::array<double, 2>;
+
+inline double cross(const real2& a, const real2& b, const real2& c) noexcept {
+  return (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+}
+
+// Returns the convex hull of the given points in counterclockwise order
+// computed by Andrew's monotone chain algorithm.
+inline auto convex_hull(std::vector<real2> p) {
+  std::sort(p.begin(), p.end());
+  p.erase(std::unique(p.begin(), p.end()), p.end());
+  if (p.size() < 3) return p;
+  std::vector<real2> hull(2 * p.size());
+  size_t k = 0;
+  for (size_t i = 0; i < p.size(); ++i) {
+    while ((k >= 2) && (cross(hull[k - 2], hull[k - 1], p[i]) <= 0)) --k;
+    hull[k++] = p[i];
+  }
+  for (size_t i = p.size() - 1, lower = k + 1; i-- > 0;) {
+    while ((k >= lower) && (cross(hull[k - 2], hull[k - 1], p[i]) <= 0)) --k;
+    hull[k++] = p[i];
+  }
+  hull.resize(k - 1);
+  return hull;
+}
+
+// Clips a convex polygon to the points whose x coordinate
+// is at most 'x' or, if 'above' is set, at least 'x'.
+inline auto clip(const std::vector<real2>& polygon, double x, bool above) {
+  const auto inside = [x, above](const real2& p) {
+    return above ? (p[0] >= x) : (p[0] <= x);
+  };
+  std::vector<real2> result{};
+  for (size_t i = 0; i < polygon.size(); ++i) {
+    const auto& a = polygon[i];
+    const auto& b = polygon[(i + 1) % polygon.size()];
+    if (inside(a)) result.push_back(a);
+    if (inside(a) == inside(b)) continue;
+    const auto t = (x - a[0]) / (b[0] - a[0]);
+    result.push_back({x, a[1] + t * (b[1] - a[1])});
+  }
+  return result;
+}
+
+// Circumcircle of the counterclockwise triangle (a, b, c) as center and
+// radius. The radius is enlarged to account for rounding errors.
+// Degenerate triangles get an infinite radius.
+inline auto circumcircle(const point& a, const point& b,
+                         const point& c) noexcept {
+  const double ux = double(b[0]) - a[0], uy = double(b[1]) - a[1];
+  const double vx = double(c[0]) - a[0], vy = double(c[1]) - a[1];
+  const double d = 2 * (ux * vy - uy * vx);
+  if (!(d > 0))
+    return std::pair{real2{a[0], a[1]},
+                     std::numeric_limits<double>::infinity()};
+  const double u2 = ux * ux + uy * uy;
+  const double v2 = vx * vx + vy * vy;
+  const double x = (vy * u2 - uy * v2) / d;
+  const double y = (ux * v2 - vx * u2) / d;
+  const double r =
+      std::sqrt(x * x + y * y) * (1 + 1e-9) + 1e-9 * std::sqrt(u2 + v2);
+  return std::pair{real2{a[0] + x, a[1] + y}, r};
+}
+
+// Returns the range of x coordinates of the intersection of the disk with
+// the convex counterclockwise polygon. The extreme points of the
+// intersection are vertices of the polygon inside the disk, intersections
+// of the circle with the edges, or extreme points of the disk inside the
+// polygon. For an empty intersection, the range is empty.
+inline auto covered_range(const std::vector<real2>& polygon, const real2& c,
+                          double r) noexcept {
+  constexpr auto infinity = std::numeric_limits<double>::infinity();
+  std::array<double, 2> range{infinity, -infinity};
+  const auto add = [&range](double x) {
+    range[0] = std::min(range[0], x);
+    range[1] = std::max(range[1], x);
+  };
+  bool inside = polygon.size() >= 3;
+  for (size_t i = 0; i < polygon.size(); ++i) {
+    const auto& a = polygon[i];
+    const auto& b = polygon[(i + 1) % polygon.size()];
+    inside &= cross(a, b, c) >= 0;
+    const real2 e{b[0] - a[0], b[1] - a[1]};
+    const real2 v{a[0] - c[0], a[1] - c[1]};
+    const auto sqr = v[0] * v[0] + v[1] * v[1] - r * r;
+    if (sqr <= 0) add(a[0]);
+    // Solve |v + t e|^2 = r^2 for t in [0, 1].
+    const auto p = e[0] * e[0] + e[1] * e[1];
+    const auto q = v[0] * e[0] + v[1] * e[1];
+    const auto discriminant = q * q - p * sqr;
+    if ((p <= 0) || (discriminant < 0)) continue;
+    const auto root = std::sqrt(discriminant);
+    for (auto t : {(-q - root) / p, (-q + root) / p})
+      if ((0 <= t) && (t <= 1)) add(a[0] + t * e[0]);
+  }
+  if (inside) {
+    add(c[0] - r);
+    add(c[0] + r);
+  }
+  return range;
+}
+
+}  // namespace detail
+
+// Triangulates the union of the points of all ranks. Global indices
+// are assigned by concatenating the points of all ranks in rank order.
+// The domain is split into vertical slabs containing about the same number
+// of points. Every rank triangulates the points of its slab together with
+// halo points of the other slabs by the quad-edge engine. A triangle is
+// final once its circumcircle intersects the convex hull of all points
+// only in the range of x coordinates for which the rank knows all points
+// or once all points inside the circle have been requested.
+// As long as some triangle around a point of the slab is not final, the
+// rank requests a larger range or the points inside its circumcircle
+// from all other ranks. Every rank returns the final triangles whose
+// smallest vertex index lies in its slab.
+// So the union over all ranks is the triangulation of all points with the
+// super triangle of their bounding box, assuming no four points are
+// cocircular. Like for the other engines, very thin triangles at the convex
+// hull may be missing and duplicated points are skipped.
+template <typename Transport>
+std::vector<triangle> triangulation(Transport& transport,
+                                    const std::vector<point>& points) {
+  using detail::append;
+  using detail::indexed_point;
+  using detail::reader;
+  constexpr auto infinity = std::numeric_limits<double>::infinity();
+  const auto rank = transport.rank();
+  const auto ranks = transport.size();
+  std::vector<message> outgoing(ranks);
+
+  // Global index offset, bounding box, and convex hull.
+  const auto local_box = bounding_box(points);
+  std::vector<detail::real2> corners(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+    corners[i] = {points[i][0], points[i][1]};
+  const auto local_hull = detail::convex_hull(std::move(corners));
+  for (auto& m : outgoing) {
+    m.clear();
+    append(m, points.size());
+    append(m, local_box);
+    append(m, local_hull.data(), local_hull.size());
+  }
+  auto incoming = detail::exchange(transport, outgoing);
+  size_t offset = 0;
+  size_t total = 0;
+  aabb box{};
+  corners.clear();
+  for (size_t r = 0; r < ranks; ++r) {
+    reader in{incoming[r]};
+    const auto count = in.read<size_t>();
+    const auto b = in.read<aabb>();
+    while (!in.done()) corners.push_back(in.read<detail::real2>());
+    if (r < rank) offset += count;
+    if (!count) continue;
+    box = total ? aabb{min(box.min, b.min), max(box.max, b.max)} : b;
+    total += count;
+  }
+  if (total < 3) return {};
+  const auto hull = detail::convex_hull(corners);
+
+  // Every rank contributes evenly spaced samples of its sorted x coordinates.
+  // All ranks compute the same slab boundaries from the same samples.
+  constexpr size_t samples = 64;
+  std::vector<float> xs(points.size());
+  for (size_t i = 0; i < points.size(); ++i) xs[i] = points[i][0];
+  std::sort(xs.begin(), xs.end());
+  std::vector<float> sample{};
+  for (size_t i = 0; (i < samples) && !xs.empty(); ++i)
+    sample.push_back(xs[i * xs.size() / samples]);
+  for (auto& m : outgoing) {
+    m.clear();
+    append(m, sample.data(), sample.size());
+  }
+  incoming = detail::exchange(transport, outgoing);
+  std::vector<float> all{};
+  for (const auto& m : incoming) {
+    const auto n = m.size() / sizeof(float);
+    const auto first = all.size();
+    all.resize(first + n);
+    reader{m}.read(all.data() + first, n);
+  }
+  std::sort(all.begin(), all.end());
+  // Slab r contains the x coordinates [splits[r - 1], splits[r]).
+  std::vector<float> splits(ranks - 1);
+  for (size_t r = 1; r < ranks; ++r)
+    splits[r - 1] = all[r * all.size() / ranks];
+  const auto owner = [&splits](const point& p) {
+    return static_cast<size_t>(
+        std::upper_bound(splits.begin(), splits.end(), p[0]) - splits.begin());
+  };
+
+  // Send every point to the rank of its slab.
+  for (auto& m : outgoing) m.clear();
+  for (size_t i = 0; i < points.size(); ++i)
+    append(outgoing[owner(points[i])], indexed_point{offset + i, points[i]});
+  incoming = detail::exchange(transport, outgoing);
+  std::vector<indexed_point> owned{};
+  for (const auto& m : incoming) {
+    const auto n = m.size() / sizeof(indexed_point);
+    const auto first = owned.size();
+    owned.resize(first + n);
+    reader{m}.read(owned.data() + first, n);
+  }
+  const auto by_index = [](const indexed_point& p, const indexed_point& q) {
+    return p.index < q.index;
+  };
+  std::sort(owned.begin(), owned.end(), by_index);
+
+  // All points with x coordinates in the open range 'known' are known.
+  std::array<double, 2> known{(rank == 0) ? -infinity : splits[rank - 1],
+                              (rank + 1 == ranks) ? infinity : splits[rank]};
+  std::vector<indexed_point> halo{};
+  std::vector<indexed_point> local{};
+  std::vector<point> positions{};
+  std::vector<triangle> triangles{};
+  const auto super = bounding_triangle(bounding_circle(box));
+  // Circumcircles along the border of a slab are huge before the halo
+  // points are known. So the halo grows by at most 'step' per round,
+  // starting at a few times the average point spacing and doubling.
+  const auto size = box.max - box.min;
+  // The padding makes sure that points on the border of the known range
+  // are requested as well.
+  const double padding = 1e-6 * std::max(size[0], size[1]);
+  std::array<double, 2> step{};
+  step.fill(4 * std::sqrt(double(size[0]) * size[1] / total) + 1e3 * padding);
+  // Circumcircles of triangles at the convex hull are huge as well,
+  // but only intersect the convex hull in a thin sliver. Instead of
+  // extending the range, all points inside large circles are requested.
+  struct disk {
+    detail::real2 center;
+    double radius;
+  };
+  std::vector<disk> queried{};
+  std::vector<disk> queries{};
+  const auto answered = [&queried](const disk& d) {
+    return std::any_of(queried.begin(), queried.end(), [&d](const disk& q) {
+      return std::hypot(d.center[0] - q.center[0], d.center[1] - q.center[1]) +
+                 d.radius <=
+             q.radius;
+    });
+  };
+  while (true) {
+    // Insert the points by ascending global index such that all ranks
+    // skip the same duplicates. The super triangle takes the first slots.
+    local.resize(owned.size() + halo.size());
+    std::merge(owned.begin(), owned.end(), halo.begin(), halo.end(),
+               local.begin(), by_index);
+    positions.assign(super.begin(), super.end());
+    for (const auto& p : local) positions.push_back(p.position);
+    guibas_stolfi::edge_algebra diagram{};
+    diagram.edges.reserve(3 * positions.size());
+    diagram.set_super_triangle(&positions[0], &positions[1], &positions[2]);
+    for (size_t i = 3; i < positions.size(); ++i) diagram.add(&positions[i]);
+    // Only the outer face consists of three super vertices.
+    triangles = diagram.triangles(positions.data(), positions.size());
+    std::erase_if(triangles, [](const triangle& t) {
+      return std::max({t[0], t[1], t[2]}) < 3;
+    });
+
+    // Unknown points lie inside the parts of the convex hull
+    // left and right of the known range. Extend the known range towards
+    // the circumcircles of all triangles around points of the slab
+    // that intersect these parts.
+    const auto left = detail::clip(hull, known[0], false);
+    const auto right = detail::clip(hull, known[1], true);
+    auto wanted = known;
+    queries.clear();
+    for (const auto& t : triangles) {
+      const auto owns = [&](size_t v) {
+        return (v >= 3) && (owner(positions[v]) == rank);
+      };
+      if (!owns(t[0]) && !owns(t[1]) && !owns(t[2])) continue;
+      const auto [center, radius] = detail::circumcircle(
+          positions[t[0]], positions[t[1]], positions[t[2]]);
+      const auto low = detail::covered_range(left, center, radius)[0];
+      const auto high = detail::covered_range(right, center, radius)[1];
+      if ((low == infinity) && (high == -infinity)) continue;
+      if (radius > std::max(step[0], step[1])) {
+        const disk d{center, radius};
+        if (!answered(d)) queries.push_back(d);
+        continue;
+      }
+      wanted[0] =
+          std::min(wanted[0], std::max(low - padding, known[0] - step[0]));
+      wanted[1] =
+          std::max(wanted[1], std::min(high + padding, known[1] + step[1]));
+    }
+    // Along the border of the slab, large circles vanish as soon as
+    // the halo is large enough. So disks are only requested
+    // if the range does not grow anymore.
+    if (wanted != known) queries.clear();
+    for (size_t i = 0; i < 2; ++i)
+      if (wanted[i] != known[i]) step[i] *= 2;
+    if (wanted[0] < box.min[0]) wanted[0] = -infinity;
+    if (wanted[1] > box.max[0]) wanted[1] = infinity;
+
+    // Every rank sends its old and new range together with its disks
+    // to all other ranks and answers with its points inside of them.
+    for (auto& m : outgoing) {
+      m.clear();
+      append(m, known);
+      append(m, wanted);
+      append(m, queries.data(), queries.size());
+    }
+    incoming = detail::exchange(transport, outgoing);
+    bool done = true;
+    std::vector<disk> disks{};
+    for (size_t r = 0; r < ranks; ++r) {
+      reader in{incoming[r]};
+      const auto old = in.read<std::array<double, 2>>();
+      const auto range = in.read<std::array<double, 2>>();
+      disks.resize((incoming[r].size() - in.offset) / sizeof(disk));
+      in.read(disks.data(), disks.size());
+      done &= (old == range) && disks.empty();
+      outgoing[r].clear();
+      if (r == rank) continue;
+      for (const auto& p : owned) {
+        const double x = p.position[0];
+        const double y = p.position[1];
+        const auto inside = [x, y](const disk& d) {
+          return std::hypot(x - d.center[0], y - d.center[1]) <= d.radius;
+        };
+        if (((range[0] < x) && (x <= old[0])) ||
+            ((old[1] <= x) && (x < range[1])) ||
+            std::any_of(disks.begin(), disks.end(), inside))
+          append(outgoing[r], p);
+      }
+    }
+    if (done) break;
+    incoming = detail::exchange(transport, outgoing);
+    for (const auto& m : incoming) {
+      const auto n = m.size() / sizeof(indexed_point);
+      const auto first = halo.size();
+      halo.resize(first + n);
+      reader{m}.read(halo.data() + first, n);
+    }
+    // Points inside of disks may have been sent before.
+    std::sort(halo.begin(), halo.end(), by_index);
+    halo.erase(std::unique(halo.begin(), halo.end(),
+                           [](const indexed_point& p, const indexed_point& q) {
+                             return p.index == q.index;
+                           }),
+               halo.end());
+    known = wanted;
+    queried.insert(queried.end(), queries.begin(), queries.end());
+  }
+
+  // Report triangles without super vertices by their smallest vertex.
+  std::vector<triangle> result{};
+  for (const auto& t : triangles) {
+    if (std::min({t[0], t[1], t[2]}) < 3) continue;
+    const triangle u{local[t[0] - 3].index, local[t[1] - 3].index,
+                     local[t[2] - 3].index};
+    const auto first = std::min_element(u.begin(), u.end()) - u.begin();
+    if (owner(positions[t[first]]) == rank) result.push_back(u);
+  }
+  return result;
+}
+
+}  // namespace lyrahgames::delaunay::distributed
@@ -0,0 +1,180 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+//
+#include <lyrahgames/delaunay/hilbert.hpp>
+#include <lyrahgames/delaunay/parallel.hpp>
+
+namespace lyrahgames::delaunay {
+
+// Result of the duplicate elimination. The unique points are ordered along
+// the Hilbert curve and can directly be used as spatially sorted input
+// for the triangulation routines.
+template <typename Point>
+struct unique_point_set {
+  std::vector<Point> points{};
+  // For every input point, the index of its representative in 'points'.
+  std::vector<size_t> remap{};
+  // For every unique point, the index of the input point it was taken from.
+  std::vector<size_t> origin{};
+};
+
+// Collapses points with equal coordinates or, for positive epsilon,
+// points whose distance is at most epsilon. The points are sorted by their
+// Hilbert keys with a parallel radix sort such that duplicates end up
+// in the same or neighboring runs of equal keys.
+// For positive epsilon, the groups are the connected components of the
+// graph whose edges connect points with a distance of at most epsilon.
+// So two points of a group may be farther apart than epsilon. The grid
+// cells have the size epsilon and so only neighboring cells have to be
+// searched. The edges are merged by a concurrent union-find structure.
+// The representative of a group of duplicates is its point
+// with the smallest index in the input.
+template <typename Point>
+auto remove_duplicates(const std::vector<Point>& points, double epsilon = 0) {
+  constexpr size_t N = dimension<Point>();
+  const auto n = points.size();
+  const auto grid = (epsilon > 0) ? make_hilbert_grid(points, epsilon)
+                                  : make_hilbert_grid(points);
+  auto keys = hilbert_keys(points, grid);
+  const auto order = sorted_order(keys);
+
+  // Every point gets a representative whose index is smaller or equal.
+  std::vector<size_t> representative(n);
+  if (epsilon > 0) {
+    constexpr size_t neighbors = [] {
+      size_t result = 1;
+      for (size_t i = 0; i < N; ++i) result *= 3;
+      return result;
+    }();
+    const auto sqepsilon = epsilon * epsilon;
+    // Every parent has a smaller index than its child. A root is linked
+    // below the other root only if it is larger. So the root of every
+    // component is its point with the smallest index.
+    std::vector<std::atomic<size_t>> parent(n);
+    for (size_t i = 0; i < n; ++i) parent[i] = i;
+    const auto find = [&parent](size_t v) {
+      auto p = parent[v].load();
+      while (p != v) {
+        // Path halving keeps every parent smaller than its child.
+        const auto q = parent[p].load();
+        if (q != p) parent[v].compare_exchange_weak(p, q);
+        v = q;
+        p = parent[v].load();
+      }
+      return v;
+    };
+    const auto unite = [&](size_t a, size_t b) {
+      while (true) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return;
+        if (a < b) std::swap(a, b);
+        auto expected = a;
+        if (parent[a].compare_exchange_strong(expected, b)) return;
+      }
+    };
+    parallel_for(n, [&](size_t, size_t first, size_t last) {
+      for (size_t k = first; k < last; ++k) {
+        const auto i = order[k];
+        const auto x = coordinates<N>(points[i]);
+        const auto c = grid.cell(points[i]);
+        for (size_t m = 0; m < neighbors; ++m) {
+          auto cell = c;
+          bool valid = true;
+          for (size_t j = 0, code = m; j < N; ++j, code /= 3) {
+            const auto offset = code % 3;
+            if (offset == 0) valid &= (cell[j] > 0);
+            if (offset == 2) valid &= (cell[j] < grid.max_cell);
+            cell[j] = cell[j] + offset - 1;
+          }
+          if (!valid) continue;
+          const auto [begin, end] = std::equal_range(
+              keys.begin(), keys.end(), hilbert_key<N>(cell));
+          // Indices inside a run of equal keys are ascending. Every pair
+          // is found from both of its points and is merged from the larger.
+          for (auto it = begin; it != end; ++it) {
+            const auto j = order[it - keys.begin()];
+            if (j >= i) break;
+            const auto y = coordinates<N>(points[j]);
+            double d = 0;
+            for (size_t l = 0; l < N; ++l) d += (x[l] - y[l]) * (x[l] - y[l]);
+            if (d <= sqepsilon) unite(i, j);
+          }
+        }
+      }
+    });
+    parallel_for(n, [&](size_t, size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) representative[i] = find(i);
+    });
+  } else {
+    // Equal points have equal keys. Clustered points or coarse keys can
+    // produce long runs of equal keys. So every run is sorted by
+    // coordinates and then by index, such that equal points follow each
+    // other and the first one has the smallest index.
+    // NaN coordinates compare greater than all others. As they are never
+    // equal, such points are not collapsed.
+    const auto less = [](double a, double b) {
+      return (a < b) || (!std::isnan(a) && std::isnan(b));
+    };
+    std::vector<size_t> sorted(order);
+    // Every run is handled by the thread owning its first key.
+    parallel_for(n, [&](size_t, size_t first, size_t last) {
+      for (size_t k = first; k < last; ++k) {
+        if ((k > 0) && (keys[k - 1] == keys[k])) continue;
+        auto end = k + 1;
+        while ((end < n) && (keys[end] == keys[k])) ++end;
+        std::sort(sorted.begin() + k, sorted.begin() + end,
+                  [&](size_t i, size_t j) {
+                    const auto x = coordinates<N>(points[i]);
+                    const auto y = coordinates<N>(points[j]);
+                    for (size_t l = 0; l < N; ++l) {
+                      if (less(x[l], y[l])) return true;
+                      if (less(y[l], x[l])) return false;
+                    }
+                    return i < j;
+                  });
+        auto r = sorted[k];
+        for (auto s = k; s < end; ++s) {
+          const auto i = sorted[s];
+          if (coordinates<N>(points[i]) != coordinates<N>(points[r])) r = i;
+          representative[i] = r;
+        }
+      }
+    });
+  }
+
+  unique_point_set<Point> result{};
+  std::vector<size_t> index(n);
+  for (size_t k = 0; k < n; ++k) {
+    const auto i = order[k];
+    if (representative[i] != i) continue;
+    index[i] = result.points.size();
+    result.points.push_back(points[i]);
+    result.origin.push_back(i);
+  }
+  result.remap.resize(n);
+  parallel_for(n, [&](size_t, size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i)
+      result.remap[i] = index[representative[i]];
+  });
+  return result;
+}
+
+// Replaces the vertex indices of elements constructed from unique points
+// by the indices of the input points they were taken from.
+template <typename Element>
+void restore_indices(std::vector<Element>& elements,
+                     const std::vector<size_t>& origin) {
+  parallel_for(elements.size(), [&](size_t, size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i)
+      for (auto& v : elements[i]) v = origin[v];
+  });
+}
+
+}  // namespace lyrahgames::delaunay
@@ -0,0 +1,244 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+//
+#include <lyrahgames/delaunay/cavity.hpp>
+#include <lyrahgames/delaunay/geometry.hpp>
+
+namespace lyrahgames::delaunay::fixed {
+
+// Heap-free triangulation of small point sets with at most N points.
+// It is the ghost variant of the Bowyer-Watson algorithm where all
+// containers are arrays with a capacity derived from N. Without any
+// allocation, the routines can be used in constant expressions and the
+// compiler is free to unroll and inline everything for tiny N.
+// The search for conflicting elements is linear in the number of
+// elements. So the run-time is quadratic and only small N are reasonable.
+
+using point = float32x2;
+using triangle = std::array<size_t, 3>;
+
+// Sequence of at most 'Capacity' elements stored inline.
+template <typename T, size_t Capacity>
+struct static_vector {
+  static constexpr size_t capacity() noexcept { return Capacity; }
+
+  constexpr size_t size() const noexcept { return count; }
+  constexpr bool empty() const noexcept { return count == 0; }
+  constexpr void clear() noexcept { count = 0; }
+
+  constexpr T& operator[](size_t i) noexcept { return data[i]; }
+  constexpr const T& operator[](size_t i) const noexcept { return data[i]; }
+  constexpr T& back() noexcept { return data[count - 1]; }
+  constexpr bool full() const noexcept { return count == Capacity; }
+
+  // The capacities are derived from bounds that only hold for exact
+  // predicates. Rounding errors of near-degenerate input may exceed them.
+  // Then, an exception is thrown instead of writing out of bounds. In
+  // constant expressions, this makes the evaluation fail to compile.
+  constexpr void push_back(const T& x) {
+    if (count == Capacity)
+      throw std::length_error("Capacity of static vector exceeded.");
+    data[count++] = x;
+  }
+  constexpr void pop_back() noexcept { --count; }
+
+  constexpr auto begin() noexcept { return data.begin(); }
+  constexpr auto begin() const noexcept { return data.begin(); }
+  constexpr auto end() noexcept { return data.begin() + count; }
+  constexpr auto end() const noexcept { return data.begin() + count; }
+
+  friend constexpr bool operator==(const static_vector& x,
+                                   const static_vector& y) noexcept {
+    return std::equal(x.begin(), x.end(), y.begin(), y.end());
+  }
+
+  std::array<T, Capacity> data{};
+  size_t count = 0;
+};
+
+// A triangulation of n points with h points on the convex hull
+// consists of 2n - 2 - h triangles and h is at least three.
+template <size_t N>
+constexpr size_t max_triangles = (N < 3) ? 0 : 2 * N - 5;
+
+template <size_t N>
+using triangles = static_vector<triangle, max_triangles<N>>;
+
+namespace detail {
+
+constexpr size_t infinity = std::numeric_limits<size_t>::max();
+
+constexpr bool equal(const point& x, const point& y) noexcept {
+  return (x[0] == y[0]) && (x[1] == y[1]);
+}
+
+constexpr bool ghost_conflict(const point& a, const point& b,
+                              const point& p) noexcept {
+  if (counterclockwise(a, b, p)) return true;
+  if (clockwise(a, b, p)) return false;
+  return strictly_between(a, b, p);
+}
+
+// State of the ghost triangulation of at most N points. The conflict
+// test for the triangles is injected into the insertion. So it can be
+// evaluated for many triangles or point sets at once beforehand.
+template <size_t N>
+struct ghost_triangulation {
+  using hull_edge = std::array<size_t, 2>;
+
+  // Finds the first three points that are not collinear and uses them as
+  // initial triangle. Returns false if there are no such points.
+  constexpr bool initialize(const point* points, size_t n) {
+    result.clear();
+    ghosts.clear();
+    seed[0] = 0;
+    seed[1] = 1;
+    while ((seed[1] < n) && equal(points[0], points[seed[1]])) ++seed[1];
+    if (seed[1] >= n) return false;
+    seed[2] = seed[1] + 1;
+    while ((seed[2] < n) &&
+           !counterclockwise(points[0], points[seed[1]], points[seed[2]]) &&
+           !clockwise(points[0], points[seed[1]], points[seed[2]]))
+      ++seed[2];
+    if (seed[2] >= n) return false;
+    if (clockwise(points[0], points[seed[1]], points[seed[2]]))
+      std::swap(seed[1], seed[2]);
+
+    result.push_back({seed[0], seed[1], seed[2]});
+    ghosts.push_back({seed[1], seed[0]});
+    ghosts.push_back({seed[2], seed[1]});
+    ghosts.push_back({seed[0], seed[2]});
+    return true;
+  }
+
+  // Points of the initial triangle are inserted already.
+  constexpr bool inserted(size_t pid) const noexcept {
+    return (pid == seed[0]) || (pid == seed[1]) || (pid == seed[2]);
+  }
+
+  // Every edge of the triangulation, including the ghost edges, appears at
+  // most once in the directed boundary of the cavity. An edge of a removed
+  // element cancels out with its reverse of a neighboring removed element.
+  // Returns false if the edge does not fit into the polygon.
+  constexpr bool add_edge(size_t a, size_t b) noexcept {
+    for (size_t i = 0; i < polygon.size(); ++i) {
+      if ((polygon[i][0] != b) || (polygon[i][1] != a)) continue;
+      polygon[i] = polygon.back();
+      polygon.pop_back();
+      return true;
+    }
+    if (polygon.full()) return false;
+    polygon.push_back({a, b});
+    return true;
+  }
+
+  // Inserts the point with the given index. 'conflict(i)' has to tell
+  // whether the point lies inside the circumcircle of the i-th triangle.
+  // The capacities only hold for exact predicates. For near-degenerate
+  // input, rounding errors can make the cavity non-star-shaped and its
+  // boundary may produce more elements than fit. Then, the point is
+  // skipped like a duplicate and nothing is changed.
+  template <typename Conflict>
+  constexpr void insert(const point* points, size_t pid, Conflict&& conflict) {
+    const auto& p = points[pid];
+    polygon.clear();
+    bad_triangles.clear();
+    bad_ghosts.clear();
+
+    // A duplicated point may only be reported to be in conflict with
+    // triangles it is a vertex of. It will not be inserted.
+    bool duplicate = false;
+    bool fits = true;
+    for (size_t i = 0; i < result.size(); ++i) {
+      if (!conflict(i)) continue;
+      const auto& t = result[i];
+      duplicate |= equal(points[t[0]], p) || equal(points[t[1]], p) ||
+                   equal(points[t[2]], p);
+      bad_triangles.push_back(i);
+      fits &= add_edge(t[0], t[1]) && add_edge(t[1], t[2]) &&
+              add_edge(t[2], t[0]);
+    }
+    for (size_t i = 0; i < ghosts.size(); ++i) {
+      const auto [a, b] = ghosts[i];
+      if (!ghost_conflict(points[a], points[b], p)) continue;
+      bad_ghosts.push_back(i);
+      fits &= add_edge(a, b) && add_edge(b, infinity) && add_edge(infinity, a);
+    }
+    if (duplicate || !fits || (bad_triangles.empty() && bad_ghosts.empty())) {
+      // Nothing has been changed.
+      bad_triangles.clear();
+      return;
+    }
+
+    // Connect every directed boundary edge of the cavity to the new point.
+    new_triangles.clear();
+    new_ghosts.clear();
+    for (const auto [from, to] : polygon) {
+      if ((from != infinity) && (to != infinity))
+        new_triangles.push_back({from, to, pid});
+      else if (new_ghosts.full())
+        fits = false;
+      else if (from == infinity)
+        new_ghosts.push_back({to, pid});
+      else
+        new_ghosts.push_back({pid, from});
+    }
+    const auto triangle_count =
+        result.size() - bad_triangles.size() + new_triangles.size();
+    const auto ghost_count =
+        ghosts.size() - bad_ghosts.size() + new_ghosts.size();
+    if (!fits || (triangle_count > result.capacity()) ||
+        (ghost_count > ghosts.capacity())) {
+      bad_triangles.clear();
+      return;
+    }
+    delaunay::detail::replace(result, bad_triangles, new_triangles);
+    delaunay::detail::replace(ghosts, bad_ghosts, new_ghosts);
+  }
+
+  triangles<N> result{};
+  static_vector<hull_edge, N> ghosts{};
+  size_t seed[3]{};
+  // Temporary storage of an insertion. After it, the slots of the removed
+  // triangles are the only ones below the old size whose content changed.
+  static_vector<hull_edge, 3 * N> polygon{};
+  static_vector<size_t, max_triangles<N>> bad_triangles{};
+  static_vector<size_t, N> bad_ghosts{};
+  static_vector<triangle, 3 * N> new_triangles{};
+  static_vector<hull_edge, N> new_ghosts{};
+};
+
+}  // namespace detail
+
+// Returns the counterclockwise Delaunay triangles of the first n points.
+// The result is the same as for 'bowyer_watson::ghost::triangulation'
+// up to the order of triangles. So the whole convex hull is triangulated
+// and duplicated points are skipped. Throws if n is larger than N.
+template <size_t N>
+constexpr auto triangulation(const point* points, size_t n) {
+  if (n > N)
+    throw std::length_error("Too many points for fixed-size triangulation.");
+  detail::ghost_triangulation<N> state{};
+  if constexpr (N < 3) return state.result;
+  if (!state.initialize(points, n)) return state.result;
+  for (size_t pid = 1; pid < n; ++pid) {
+    if (state.inserted(pid)) continue;
+    state.insert(points, pid, [&](size_t i) {
+      const auto& t = state.result[i];
+      return bool(circumcircle_intersection(points[t[0]], points[t[1]],
+                                            points[t[2]], points[pid]));
+    });
+  }
+  return state.result;
+}
+
+template <size_t N>
+constexpr auto triangulation(const std::array<point, N>& points) {
+  return triangulation<N>(points.data(), N);
+}
+
+}  // namespace lyrahgames::delaunay::fixed
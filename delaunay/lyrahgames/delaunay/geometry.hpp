@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <bit>
 #include <cmath>
 #include <cstdint>
 #include <vector>
@@ -22,6 +23,13 @@ constexpr auto clockwise(const float32x2& a, const float32x2& b,
   return (u[0] * v[1] - u[1] * v[0]) < 0;
 }
 
+// Assuming that a, b, and p are collinear, tests
+// if p lies in the interior of the segment from a to b.
+constexpr auto strictly_between(const float32x2& a, const float32x2& b,
+                                const float32x2& p) noexcept {
+  return (dot(p - a, b - a) > 0) && (dot(p - b, a - b) > 0);
+}
+
 constexpr auto circumcircle_intersection(const float32x2& a,  //
                                          const float32x2& b,  //
                                          const float32x2& c,  //
@@ -40,8 +48,8 @@ constexpr auto circumcircle_intersection(const float32x2& a,  //
                            r[1] * (u[0] * v2 - v[0] * u2) + r2 * orientation;
 
   // return orientation * determinant < 0;
-  return (reinterpret_cast<const uint32_t&>(orientation) ^
-          reinterpret_cast<const uint32_t&>(determinant)) >>
+  return (std::bit_cast<uint32_t>(orientation) ^
+          std::bit_cast<uint32_t>(determinant)) >>
          31u;
 };
 
@@ -67,8 +75,8 @@ constexpr auto circumcircle_intersection(const float32x2& a,
   const auto [x, y, orientation] = cache;
   const auto determinant = r[0] * x - r[1] * y + r2 * orientation;
   // return orientation * determinant < 0;
-  return (reinterpret_cast<const uint32_t&>(orientation) ^
-          reinterpret_cast<const uint32_t&>(determinant)) >>
+  return (std::bit_cast<uint32_t>(orientation) ^
+          std::bit_cast<uint32_t>(determinant)) >>
          31u;
 };
 
@@ -1,8 +1,11 @@
 #pragma once
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 //
 #include <lyrahgames/delaunay/geometry.hpp>
+#include <lyrahgames/delaunay/statistics.hpp>
 
 namespace lyrahgames::delaunay::guibas_stolfi {
 
@@ -129,9 +132,14 @@ struct edge_algebra {
   void swap(edge* e) noexcept;
   auto right_of(const point& x, edge* e) noexcept;
   auto left_of(const point& x, edge* e) noexcept;
-  auto locate(const point& x) noexcept;
-  void add(point* p) noexcept;
+  auto coincides(const point& x, edge* e) noexcept;
+  template <typename Statistics = no_statistics>
+  auto locate(const point& x, Statistics&& statistics = {}) noexcept;
+  template <typename Statistics = no_statistics>
+  void add(point* p, Statistics&& statistics = {}) noexcept;
   void set_super_triangle(point* a, point* b, point* c) noexcept;
+  auto hull(const point* first) noexcept;
+  auto triangles(const point* first, size_t n) const;
 
   std::vector<quad_edge> edges;
 };
@@ -247,23 +255,68 @@ inline auto edge_algebra::left_of(const point& x, edge* e) noexcept {
                           *static_cast<point*>(destination(e)));
 }
 
-inline auto edge_algebra::locate(const point& x) noexcept {
+// Checks if x equals the origin or destination of e.
+inline auto edge_algebra::coincides(const point& x, edge* e) noexcept {
+  const auto& o = *static_cast<point*>(origin(e));
+  const auto& d = *static_cast<point*>(destination(e));
+  return ((x[0] == o[0]) && (x[1] == o[1])) ||
+         ((x[0] == d[0]) && (x[1] == d[1]));
+}
+
+// Tests if x lies inside the circumcircle of the triangle (a, b, c).
+// Flips compare tiny triangles with the far away super triangle vertices.
+// In float precision, rounding then swaps edges of non-convex
+// quadrilaterals and the subdivision overlaps. The determinant is
+// evaluated in double precision instead. It is not exact, but its rounding
+// errors are far smaller and the flip loops stay consistent in practice.
+inline bool inside_circumcircle(const point& a, const point& b,
+                                const point& c, const point& x) noexcept {
+  const double ax = double(a[0]) - x[0], ay = double(a[1]) - x[1];
+  const double bx = double(b[0]) - x[0], by = double(b[1]) - x[1];
+  const double cx = double(c[0]) - x[0], cy = double(c[1]) - x[1];
+  const double determinant = (ax * ax + ay * ay) * (bx * cy - by * cx) -
+                             (bx * bx + by * by) * (ax * cy - ay * cx) +
+                             (cx * cx + cy * cy) * (ax * by - ay * bx);
+  const double orientation = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+  return determinant * orientation > 0;
+}
+
+template <typename Statistics>
+inline auto edge_algebra::locate(const point& x,
+                                 Statistics&& statistics) noexcept {
+  const auto right_of_x = [&](edge* e) {
+    statistics.test_orientation();
+    return right_of(x, e);
+  };
   auto e = &edges[0][0];
-  while (true) {
-    if (right_of(x, e))
+  size_t steps = 0;
+  for (;; ++steps) {
+    // For an already inserted point, the walk would cycle around it forever.
+    if (coincides(x, e))
+      break;
+    else if (right_of_x(e))
       e = symmetric(e);
-    else if (!right_of(x, next(e)))
+    else if (!right_of_x(next(e)))
       e = next(e);
-    else if (!right_of(x, rotation(next(rotation(e, -1)), -1)))
+    else if (!right_of_x(rotation(next(rotation(e, -1)), -1)))
       e = rotation(next(rotation(e, -1)), -1);
     else
-      return e;
+      break;
   }
+  statistics.walk(steps);
+  return e;
 }
 
-inline void edge_algebra::add(point* p) noexcept {
+template <typename Statistics>
+inline void edge_algebra::add(point* p, Statistics&& statistics) noexcept {
   auto& x = *p;
-  auto e = locate(x);
+  auto e = locate(x, statistics);
+  // Duplicated points are ignored.
+  if (coincides(x, e)) {
+    statistics.skip_duplicate();
+    return;
+  }
+  statistics.insert();
   auto base = new_edge();
   origin(base) = origin(e);
   destination(base) = p;
@@ -277,10 +330,14 @@ inline void edge_algebra::add(point* p) noexcept {
 
   do {
     auto t = previous(e);
-    if (right_of(*static_cast<point*>(destination(t)), e) &&
-        circumcircle_intersection(*static_cast<point*>(origin(e)),
-                                  *static_cast<point*>(destination(t)),
-                                  *static_cast<point*>(destination(e)), x)) {
+    const auto& d = *static_cast<point*>(destination(t));
+    const bool convex = right_of(d, e);
+    statistics.test_orientation();
+    statistics.test_incircle(convex);
+    if (convex &&
+        inside_circumcircle(*static_cast<point*>(origin(e)), d,
+                            *static_cast<point*>(destination(e)), x)) {
+      statistics.flip();
       swap(e);
       e = previous(e);
     } else if (next(e) == first)
@@ -310,4 +367,60 @@ inline void edge_algebra::set_super_triangle(point* a, point* b,
   splice(symmetric(t), u);
 }
 
+// Returns the indices, relative to 'first', of the boundary vertices of all
+// points inserted after the counterclockwise super triangle in
+// counterclockwise order. For a sufficiently large super triangle,
+// this is the convex hull. Only edges incident to the super triangle
+// are visited and so the run-time is proportional to the hull size.
+inline auto edge_algebra::hull(const point* first) noexcept {
+  // The edges of the super triangle are never swapped.
+  // So they can be found at the beginning of the edge vector.
+  const void* super[3] = {origin(&edges[0][0]),  //
+                          origin(&edges[1][0]),  //
+                          origin(&edges[2][0])};
+  const auto is_super = [&super](const void* p) {
+    return (p == super[0]) || (p == super[1]) || (p == super[2]);
+  };
+
+  // For every super vertex, walk clockwise through its ring of edges
+  // starting after the previous super vertex. The real destinations form
+  // a chain of the hull whose last vertex is the first of the next chain.
+  edge* start[3] = {symmetric(&edges[2][0]),  //
+                    symmetric(&edges[0][0]),  //
+                    symmetric(&edges[1][0])};
+  std::vector<size_t> result{};
+  for (auto s : start) {
+    for (auto e = previous(s); !is_super(destination(e)); e = previous(e)) {
+      const auto index =
+          static_cast<size_t>(static_cast<point*>(destination(e)) - first);
+      if (result.empty() || (result.back() != index)) result.push_back(index);
+    }
+  }
+  if ((result.size() > 1) && (result.front() == result.back()))
+    result.pop_back();
+  return result;
+}
+
+// Returns the counterclockwise triangles of the subdivision whose vertices
+// are contained in the range [first, first + n) as indices relative to
+// 'first'. Triangles incident to the super triangle are skipped.
+inline auto edge_algebra::triangles(const point* first, size_t n) const {
+  const auto index = [first](edge* e) {
+    return static_cast<size_t>(static_cast<const point*>(origin(e)) - first);
+  };
+  std::vector<std::array<size_t, 3>> result{};
+  for (const auto& q : edges) {
+    // Every face is reported by its primal edge with the lowest address.
+    for (auto e : {const_cast<edge*>(&q[0]), const_cast<edge*>(&q[2])}) {
+      const auto f = rotation(next(rotation(e, -1)), 1);
+      const auto g = rotation(next(rotation(f, -1)), 1);
+      if ((rotation(next(rotation(g, -1)), 1) != e) || (f < e) || (g < e))
+        continue;
+      const std::array<size_t, 3> t{index(e), index(f), index(g)};
+      if ((t[0] < n) && (t[1] < n) && (t[2] < n)) result.push_back(t);
+    }
+  }
+  return result;
+}
+
 }  // namespace lyrahgames::delaunay::guibas_stolfi
\ No newline at end of file
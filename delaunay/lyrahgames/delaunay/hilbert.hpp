@@ -0,0 +1,197 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+//
+#include <lyrahgames/delaunay/parallel.hpp>
+#include <lyrahgames/delaunay/radix_sort.hpp>
+
+namespace lyrahgames::delaunay {
+
+// Number of spatial dimensions of a point type. Points with a tuple size
+// or a static 'size' function report it directly. Otherwise, public members
+// 'x', 'y', and optionally 'z' are assumed.
+template <typename Point>
+constexpr size_t dimension() noexcept {
+  if constexpr (requires { std::tuple_size<Point>::value; })
+    return std::tuple_size<Point>::value;
+  else if constexpr (requires { Point::size(); })
+    return Point::size();
+  else if constexpr (requires(const Point& p) { p.z; })
+    return 3;
+  else
+    return 2;
+}
+
+template <size_t N, typename Point>
+constexpr auto coordinates(const Point& p) noexcept {
+  std::array<double, N> x{};
+  if constexpr (requires { p[0]; }) {
+    for (size_t i = 0; i < N; ++i) x[i] = p[i];
+  } else {
+    x[0] = p.x;
+    x[1] = p.y;
+    if constexpr (N > 2) x[2] = p.z;
+  }
+  return x;
+}
+
+// Number of bits per coordinate such that a Hilbert key fits into 64 bits.
+template <size_t N>
+constexpr size_t hilbert_bits = 64 / N;
+
+// Computes the index of a cell with the given integer coordinates on the
+// Hilbert curve of the given order by Skilling's algorithm
+// ("Programming the Hilbert curve", 2004). The coordinates are transformed
+// into the transposed Hilbert index whose bits are interleaved afterwards.
+// For a fixed order, the mapping is a bijection.
+template <size_t N>
+constexpr uint64_t hilbert_key(std::array<uint32_t, N> x,
+                               size_t bits = hilbert_bits<N>) noexcept {
+  const uint32_t m = uint32_t{1} << (bits - 1);
+  // Inverse undo of the excess work.
+  for (uint32_t q = m; q > 1; q >>= 1) {
+    const uint32_t p = q - 1;
+    for (size_t i = 0; i < N; ++i) {
+      if (x[i] & q) {
+        x[0] ^= p;
+      } else {
+        const auto t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+  // Gray encode.
+  for (size_t i = 1; i < N; ++i) x[i] ^= x[i - 1];
+  uint32_t t = 0;
+  for (uint32_t q = m; q > 1; q >>= 1)
+    if (x[N - 1] & q) t ^= q - 1;
+  for (size_t i = 0; i < N; ++i) x[i] ^= t;
+
+  uint64_t key = 0;
+  for (size_t b = bits; b-- > 0;)
+    for (size_t i = 0; i < N; ++i) key = (key << 1) | ((x[i] >> b) & 1);
+  return key;
+}
+
+// Uniform grid of cubic cells covering the bounding box of a point set.
+// It maps points to the integer coordinates used to compute Hilbert keys.
+template <size_t N>
+struct hilbert_grid {
+  static constexpr uint32_t max_cell = (uint64_t{1} << hilbert_bits<N>) - 1;
+
+  template <typename Point>
+  auto cell(const Point& p) const noexcept {
+    const auto x = coordinates<N>(p);
+    std::array<uint32_t, N> result{};
+    for (size_t i = 0; i < N; ++i) {
+      const auto c = std::floor((x[i] - origin[i]) * scale);
+      result[i] = static_cast<uint32_t>(
+          std::clamp(c, 0.0, static_cast<double>(max_cell)));
+    }
+    return result;
+  }
+
+  template <typename Point>
+  auto key(const Point& p) const noexcept {
+    return hilbert_key<N>(cell(p));
+  }
+
+  std::array<double, N> origin{};
+  // Number of cells per unit length.
+  double scale{};
+};
+
+template <size_t N, typename Point>
+auto bounding_box(const std::vector<Point>& points) {
+  using box = std::array<std::array<double, N>, 2>;
+  const auto threads = thread_count(points.size());
+  std::vector<box> boxes(threads);
+  parallel_for(points.size(), threads,
+               [&](size_t t, size_t first, size_t last) {
+                 auto& [low, high] = boxes[t];
+                 low.fill(INFINITY);
+                 high.fill(-INFINITY);
+                 for (size_t i = first; i < last; ++i) {
+                   const auto x = coordinates<N>(points[i]);
+                   for (size_t k = 0; k < N; ++k) {
+                     low[k] = std::min(low[k], x[k]);
+                     high[k] = std::max(high[k], x[k]);
+                   }
+                 }
+               });
+  auto result = boxes[0];
+  for (size_t t = 1; t < threads; ++t) {
+    for (size_t k = 0; k < N; ++k) {
+      result[0][k] = std::min(result[0][k], boxes[t][0][k]);
+      result[1][k] = std::max(result[1][k], boxes[t][1][k]);
+    }
+  }
+  return result;
+}
+
+// Constructs the finest grid of the Hilbert curve covering all points.
+template <typename Point, size_t N = dimension<Point>()>
+auto make_hilbert_grid(const std::vector<Point>& points) {
+  hilbert_grid<N> grid{};
+  if (points.empty()) return grid;
+  const auto [low, high] = bounding_box<N>(points);
+  double extent = 0;
+  for (size_t k = 0; k < N; ++k) extent = std::max(extent, high[k] - low[k]);
+  grid.origin = low;
+  grid.scale = (extent > 0) ? (grid.max_cell / extent) : 0;
+  return grid;
+}
+
+// Constructs a grid of the Hilbert curve with the given cell size.
+// Throws if the points cannot be covered by the available bits.
+template <typename Point, size_t N = dimension<Point>()>
+auto make_hilbert_grid(const std::vector<Point>& points, double cell_size) {
+  if (!(cell_size > 0))
+    throw std::invalid_argument("Cell size of Hilbert grid must be positive.");
+  hilbert_grid<N> grid{};
+  if (points.empty()) return grid;
+  const auto [low, high] = bounding_box<N>(points);
+  grid.origin = low;
+  grid.scale = 1 / cell_size;
+  for (size_t k = 0; k < N; ++k)
+    if ((high[k] - low[k]) * grid.scale >= grid.max_cell)
+      throw std::invalid_argument(
+          "Cell size of Hilbert grid is too small for the given points.");
+  return grid;
+}
+
+template <typename Point, size_t N>
+auto hilbert_keys(const std::vector<Point>& points,
+                  const hilbert_grid<N>& grid) {
+  std::vector<uint64_t> keys(points.size());
+  parallel_for(points.size(), [&](size_t, size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) keys[i] = grid.key(points[i]);
+  });
+  return keys;
+}
+
+// Sorts the given keys and returns the permutation that was applied.
+inline auto sorted_order(std::vector<uint64_t>& keys) {
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  radix_sort(keys, order);
+  return order;
+}
+
+// Returns the permutation of point indices ordered along the Hilbert curve.
+// Equal keys keep their relative input order.
+template <typename Point>
+auto hilbert_order(const std::vector<Point>& points) {
+  auto keys = hilbert_keys(points, make_hilbert_grid(points));
+  return sorted_order(keys);
+}
+
+}  // namespace lyrahgames::delaunay
@@ -0,0 +1,519 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+//
+#include <lyrahgames/delaunay/connectivity.hpp>
+#include <lyrahgames/delaunay/parallel.hpp>
+#include <lyrahgames/delaunay/proximity.hpp>
+#include <lyrahgames/delaunay/vector.hpp>
+
+namespace lyrahgames::delaunay {
+
+// Regular grid of cells whose interpolated values are written directly
+// into a caller-provided buffer. The cell in column i and row j has its
+// center at origin + (i * spacing[0], j * spacing[1]) and its value is
+// stored at data[j * row_stride + i * column_stride]. Cells outside of
+// the convex hull of the points are set to the 'outside' value.
+struct raster {
+  float32x2 origin{};
+  float32x2 spacing{1, 1};
+  size_t columns{};
+  size_t rows{};
+  float* data{};
+  ptrdiff_t row_stride{};
+  ptrdiff_t column_stride{1};
+  float outside = std::numeric_limits<float>::quiet_NaN();
+};
+
+namespace detail {
+
+// Triangle mesh with connectivity used to locate the raster cells.
+template <typename Triangles>
+struct interpolation_mesh {
+  static constexpr size_t none = connectivity<3>::none;
+
+  auto vertex(size_t t, size_t k) const noexcept {
+    return points[triangles[t][k]];
+  }
+
+  // The barycentric coordinates are affine functions of the position.
+  // Returns their values at x together with their increments
+  // from one raster column to the next.
+  auto barycentric(size_t t, const float32x2& x, float step) const noexcept {
+    const auto a = vertex(t, 0);
+    const auto b = vertex(t, 1);
+    const auto c = vertex(t, 2);
+    const auto inverse = 1 / cross(b - a, c - a);
+    std::array<float, 3> l, dl;
+    const float32x2 v[3] = {a, b, c};
+    for (size_t k = 0; k < 3; ++k) {
+      const auto& p = v[(k + 1) % 3];
+      const auto e = v[(k + 2) % 3] - p;
+      l[k] = cross(e, x - p) * inverse;
+      dl[k] = -e[1] * step * inverse;
+    }
+    return std::pair{l, dl};
+  }
+
+  // Visibility walk starting at triangle t. If x lies outside of the
+  // convex hull, which is the case if it lies outside of any hull edge
+  // on the way, 'edge' is set to the index of the vertex opposite to
+  // this hull edge in the returned triangle. Otherwise, it is 'none'.
+  // If rounding errors let the walk cycle, all triangles are tested
+  // and 'none' is returned if none of them contains x.
+  size_t locate(size_t t, const float32x2& x, size_t& edge) const noexcept {
+    edge = none;
+    for (size_t steps = 0; steps < triangles.size(); ++steps) {
+      const auto [l, _] = barycentric(t, x, 0);
+      const auto k = std::min_element(l.begin(), l.end()) - l.begin();
+      if (l[k] >= 0) return t;
+      for (size_t i = 0; i < 3; ++i) {
+        if ((l[i] >= 0) || (adjacency.neighbors[t][i] != none)) continue;
+        edge = i;
+        return t;
+      }
+      t = adjacency.neighbors[t][k];
+    }
+    for (t = 0; t < triangles.size(); ++t) {
+      const auto [l, _] = barycentric(t, x, 0);
+      if (std::min({l[0], l[1], l[2]}) >= 0) return t;
+    }
+    return none;
+  }
+
+  static auto cross(const float32x2& x, const float32x2& y) noexcept {
+    return x[0] * y[1] - x[1] * y[0];
+  }
+
+  const std::vector<float32x2>& points;
+  const Triangles& triangles;
+  const connectivity<3>& adjacency;
+};
+
+// Rows are processed in parallel by the returned number of threads.
+inline size_t raster_threads(const raster& grid) noexcept {
+  return std::min(grid.rows, thread_count(grid.rows * grid.columns));
+}
+
+// Splits every raster row into spans of consecutive cells inside the same
+// triangle and calls span(thread, t, row, first, last, l, dl) for them,
+// where l are the barycentric coordinates of the first cell and dl their
+// increments per column. Every row is walked coherently starting at the
+// triangle of its previous cell and the first cell of a row starts at
+// the first triangle of the previous row.
+template <typename Triangles, typename Functor>
+void for_each_span(const interpolation_mesh<Triangles>& mesh,
+                   const raster& grid, Functor&& span) {
+  if (mesh.triangles.empty()) {
+    for (size_t j = 0; j < grid.rows; ++j)
+      for (size_t i = 0; i < grid.columns; ++i)
+        grid.data[j * grid.row_stride + i * grid.column_stride] = grid.outside;
+    return;
+  }
+  parallel_for(grid.rows, raster_threads(grid),
+               [&](size_t thread, size_t first, size_t last) {
+                 size_t row_start = 0;
+                 for (size_t j = first; j < last; ++j) {
+                   const auto y = grid.origin[1] + j * grid.spacing[1];
+                   auto t = row_start;
+                   bool first_cell = true;
+                   size_t i = 0;
+                   while (i < grid.columns) {
+                     const float32x2 x{grid.origin[0] + i * grid.spacing[0],
+                                       y};
+                     size_t edge;
+                     const auto s = mesh.locate(t, x, edge);
+                     if (s == mesh.none) {
+                       grid.data[j * grid.row_stride +
+                                 i * grid.column_stride] = grid.outside;
+                       ++i;
+                       continue;
+                     }
+                     t = s;
+                     const auto [l, dl] = mesh.barycentric(t, x,
+                                                           grid.spacing[0]);
+                     // All cells on the outer side of the hull edge
+                     // are skipped at once.
+                     if (edge != mesh.none) {
+                       auto end = grid.columns;
+                       if (dl[edge] > 0) {
+                         const auto n = std::ceil(double(-l[edge]) / dl[edge]);
+                         end = std::min(end, i + size_t(std::max(n, 1.0)));
+                       }
+                       for (; i < end; ++i)
+                         grid.data[j * grid.row_stride +
+                                   i * grid.column_stride] = grid.outside;
+                       continue;
+                     }
+                     if (first_cell) row_start = t;
+                     first_cell = false;
+
+                     // The cells of the span are the ones for which
+                     // all barycentric coordinates stay non-negative.
+                     auto end = grid.columns;
+                     for (size_t k = 0; k < 3; ++k) {
+                       if (dl[k] >= 0) continue;
+                       const auto n = std::floor(double(l[k]) / -dl[k]) + 1;
+                       end = std::min(end, i + size_t(std::max(n, 1.0)));
+                     }
+                     span(thread, t, j, i, end, l, dl);
+                     i = end;
+                   }
+                 }
+               });
+}
+
+// Small dense linear system solved by Gaussian elimination
+// with partial pivoting. Returns false for nearly singular systems
+// whose pivots fall below the given fraction of the largest entry.
+template <size_t N>
+bool solve(std::array<std::array<double, N>, N>& a, std::array<double, N>& b,
+           double tolerance) noexcept {
+  double scale = 0;
+  for (const auto& row : a)
+    for (auto x : row) scale = std::max(scale, std::abs(x));
+  for (size_t k = 0; k < N; ++k) {
+    size_t pivot = k;
+    for (size_t i = k + 1; i < N; ++i)
+      if (std::abs(a[i][k]) > std::abs(a[pivot][k])) pivot = i;
+    if (std::abs(a[pivot][k]) <= tolerance * scale) return false;
+    std::swap(a[k], a[pivot]);
+    std::swap(b[k], b[pivot]);
+    for (size_t i = k + 1; i < N; ++i) {
+      const auto s = a[i][k] / a[k][k];
+      for (size_t l = k; l < N; ++l) a[i][l] -= s * a[k][l];
+      b[i] -= s * b[k];
+    }
+  }
+  for (size_t k = N; k-- > 0;) {
+    for (size_t l = k + 1; l < N; ++l) b[k] -= a[k][l] * b[l];
+    b[k] /= a[k][k];
+  }
+  return true;
+}
+
+// Least-squares fit of a polynomial with vanishing constant term
+// to the value differences of a vertex and its neighbors.
+// The first two coefficients are the gradient. Every equation is divided
+// by the distance of the neighbor such that near and far neighbors
+// are weighted equally. Nearly degenerate neighborhoods, for example
+// when the neighbors of a quadratic fit lie close to a conic, are rejected.
+template <size_t N>
+bool fit_gradient(const std::vector<float32x2>& points,
+                  const std::vector<float>& values, size_t v,
+                  std::span<const size_t> neighbors, double tolerance,
+                  float32x2& gradient) {
+  std::array<std::array<double, N>, N> a{};
+  std::array<double, N> b{};
+  for (auto u : neighbors) {
+    const double dx = double(points[u][0]) - points[v][0];
+    const double dy = double(points[u][1]) - points[v][1];
+    const auto d = std::sqrt(dx * dx + dy * dy);
+    if (d == 0) continue;
+    const double row[5] = {dx / d, dy / d, dx * dx / (2 * d), dx * dy / d,
+                           dy * dy / (2 * d)};
+    const double df = (double(values[u]) - values[v]) / d;
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t k = 0; k < N; ++k) a[i][k] += row[i] * row[k];
+      b[i] += row[i] * df;
+    }
+  }
+  if (!solve(a, b, tolerance)) return false;
+  gradient = float32x2{float(b[0]), float(b[1])};
+  return true;
+}
+
+}  // namespace detail
+
+// Estimates the gradients of the scattered data at all points by fitting
+// a quadratic polynomial to the values of the Delaunay neighbors.
+// Vertices with less than five neighbors use a linear fit instead.
+// The estimate is exact for quadratic data.
+inline std::vector<float32x2> estimate_gradients(
+    const std::vector<float32x2>& points, const graph& delaunay,
+    const std::vector<float>& values) {
+  std::vector<float32x2> result(points.size(), float32x2{0, 0});
+  parallel_for(points.size(), [&](size_t, size_t first, size_t last) {
+    for (size_t v = first; v < last; ++v) {
+      const auto neighbors = delaunay.neighbors(v);
+      if ((neighbors.size() >= 5) &&
+          detail::fit_gradient<5>(points, values, v, neighbors, 1e-3,
+                                  result[v]))
+        continue;
+      if (neighbors.size() >= 2)
+        detail::fit_gradient<2>(points, values, v, neighbors, 1e-9,
+                                result[v]);
+    }
+  });
+  return result;
+}
+
+// Piecewise linear interpolation of the values given at the points.
+// Along a span of cells inside one triangle, the interpolant is an affine
+// function of the column. So the inner loop only consists of one
+// multiply-add per cell and is vectorized by the compiler.
+template <typename Triangles>
+void linear_interpolation(const std::vector<float32x2>& points,
+                          const Triangles& triangles,
+                          const connectivity<3>& adjacency,
+                          const std::vector<float>& values,
+                          const raster& grid) {
+  const detail::interpolation_mesh<Triangles> mesh{points, triangles,
+                                                   adjacency};
+  detail::for_each_span(
+      mesh, grid,
+      [&](size_t, size_t t, size_t row, size_t first, size_t last,
+          const std::array<float, 3>& l, const std::array<float, 3>& dl) {
+        const auto& v = triangles[t];
+        const auto a =
+            values[v[0]] * l[0] + values[v[1]] * l[1] + values[v[2]] * l[2];
+        const auto b = values[v[0]] * dl[0] + values[v[1]] * dl[1] +
+                       values[v[2]] * dl[2];
+        const auto stride = grid.column_stride;
+        const auto out =
+            grid.data + row * grid.row_stride + first * grid.column_stride;
+        const auto n = last - first;
+        for (size_t i = 0; i < n; ++i) out[i * stride] = a + b * float(i);
+      });
+}
+
+// Natural neighbor interpolation by Sibson's coordinates. The weight of
+// a natural neighbor v is the area that the Voronoi cell of the inserted
+// cell center x would steal from the cell of v. The stolen regions are
+// bounded by pieces of the old Voronoi edges dual to the cavity edges,
+// which are the edges of the triangles whose circumcircle contains x,
+// and by the new Voronoi edges between x and the vertices on the cavity
+// boundary. The areas are accumulated by the shoelace formula in double
+// precision with x as origin. On the convex hull, the interpolant reduces
+// to linear interpolation along the hull edge, which is used directly.
+template <typename Triangles>
+void natural_neighbor_interpolation(const std::vector<float32x2>& points,
+                                    const Triangles& triangles,
+                                    const connectivity<3>& adjacency,
+                                    const std::vector<float>& values,
+                                    const raster& grid) {
+  const auto cross = [](const float64x2& x, const float64x2& y) {
+    return x[0] * y[1] - x[1] * y[0];
+  };
+  // Circumcenter of the triangle (0, a, b).
+  const auto circumcenter = [&cross](const float64x2& a, const float64x2& b) {
+    const auto a2 = a[0] * a[0] + a[1] * a[1];
+    const auto b2 = b[0] * b[0] + b[1] * b[1];
+    const auto d = 2 * cross(a, b);
+    return float64x2{(b[1] * a2 - a[1] * b2) / d, (a[0] * b2 - b[0] * a2) / d};
+  };
+
+  struct cavity_element {
+    size_t t;
+    float64x2 center;
+  };
+  struct neighbor {
+    size_t v;
+    double area = 0;
+    float64x2 in{}, out{};
+  };
+  struct buffers {
+    std::vector<cavity_element> cavity{};
+    std::vector<size_t> stack{};
+    std::vector<neighbor> neighbors{};
+  };
+  std::vector<buffers> threads(detail::raster_threads(grid));
+
+  const detail::interpolation_mesh<Triangles> mesh{points, triangles,
+                                                   adjacency};
+  detail::for_each_span(
+      mesh, grid,
+      [&](size_t thread, size_t t, size_t row, size_t first, size_t last,
+          const std::array<float, 3>& l0, const std::array<float, 3>& dl) {
+        auto& [cavity, stack, neighbors] = threads[thread];
+        const auto y = grid.origin[1] + row * grid.spacing[1];
+        const auto relative = [&](const float32x2& x, size_t v) {
+          return float64x2{double(points[v][0]) - x[0],
+                         double(points[v][1]) - x[1]};
+        };
+        const auto find = [&](size_t v) -> neighbor& {
+          for (auto& n : neighbors)
+            if (n.v == v) return n;
+          return neighbors.emplace_back(neighbor{v});
+        };
+        const auto in_cavity = [&](size_t s) {
+          for (const auto& e : cavity)
+            if (e.t == s) return &e;
+          return static_cast<const cavity_element*>(nullptr);
+        };
+
+        for (auto i = first; i < last; ++i) {
+          const float32x2 x{grid.origin[0] + i * grid.spacing[0], y};
+          auto& out = grid.data[row * grid.row_stride + i * grid.column_stride];
+          const auto& v = triangles[t];
+          const float s = i - first;
+          const std::array<float, 3> l{l0[0] + s * dl[0], l0[1] + s * dl[1],
+                                       l0[2] + s * dl[2]};
+          const auto linear =
+              values[v[0]] * l[0] + values[v[1]] * l[1] + values[v[2]] * l[2];
+
+          // Collect the cavity by a breadth-first search.
+          cavity.clear();
+          stack.assign(1, t);
+          while (!stack.empty()) {
+            const auto s = stack.back();
+            stack.pop_back();
+            if (in_cavity(s)) continue;
+            const auto& w = triangles[s];
+            const auto a = relative(x, w[0]);
+            const auto b = relative(x, w[1]);
+            const auto c = relative(x, w[2]);
+            const auto orientation = cross(b - a, c - a);
+            const auto inside = (a[0] * a[0] + a[1] * a[1]) * cross(b, c) +
+                                (b[0] * b[0] + b[1] * b[1]) * cross(c, a) +
+                                (c[0] * c[0] + c[1] * c[1]) * cross(a, b);
+            if ((s != t) && (inside * orientation <= 0)) continue;
+            // The center of (a, b, c) relative to x.
+            const auto center = a + circumcenter(b - a, c - a);
+            cavity.push_back({s, center});
+            for (auto n : adjacency.neighbors[s])
+              if (n != mesh.none) stack.push_back(n);
+          }
+
+          // Every cavity edge (p, q) with orientation of its triangle
+          // contributes the piece of its dual Voronoi edge from the
+          // circumcenter to the midpoint of the neighboring circumcenter
+          // or to the new Voronoi vertex on the cavity boundary.
+          neighbors.clear();
+          bool degenerate = false;
+          for (const auto& [s, center] : cavity) {
+            const auto& w = triangles[s];
+            const auto positive =
+                cross(relative(x, w[1]) - relative(x, w[0]),
+                      relative(x, w[2]) - relative(x, w[0])) > 0;
+            for (size_t k = 0; k < 3; ++k) {
+              auto p = w[(k + 1) % 3];
+              auto q = w[(k + 2) % 3];
+              if (!positive) std::swap(p, q);
+              const auto other = in_cavity(adjacency.neighbors[s][k]);
+              float64x2 dual;
+              if (other) {
+                dual = 0.5 * (center + other->center);
+              } else {
+                const auto a = relative(x, p);
+                const auto b = relative(x, q);
+                if (cross(a, b) <= 0) {
+                  degenerate = true;
+                  break;
+                }
+                dual = circumcenter(a, b);
+                find(p).out = dual;
+                find(q).in = dual;
+              }
+              const auto area = cross(center, dual);
+              find(q).area += area;
+              find(p).area -= area;
+            }
+            if (degenerate) break;
+          }
+          if (degenerate) {
+            out = linear;
+            continue;
+          }
+
+          // The new Voronoi edge between x and v closes its stolen region.
+          double sum = 0;
+          double result = 0;
+          for (auto& n : neighbors) {
+            n.area += cross(n.out, n.in);
+            sum += n.area;
+            result += n.area * values[n.v];
+          }
+          out = (sum > 0) ? float(result / sum) : linear;
+        }
+      });
+}
+
+// Clough-Tocher interpolation splits every triangle at its centroid into
+// three cubic Bézier patches which are continuously differentiable.
+// The control points next to the vertices are given by the gradients
+// at the vertices. If no gradients are provided, they are estimated.
+// The normal derivative along every edge is chosen to be linear such that
+// neighboring triangles join smoothly. The remaining control points
+// follow from the smoothness conditions inside of the triangle.
+template <typename Triangles>
+void clough_tocher_interpolation(
+    const std::vector<float32x2>& points, const Triangles& triangles,
+    const connectivity<3>& adjacency, const std::vector<float>& values,
+    const raster& grid, const std::vector<float32x2>* gradients = nullptr) {
+  std::vector<float32x2> estimate{};
+  if (!gradients) {
+    estimate = estimate_gradients(
+        points, delaunay_graph<3>(triangles, points.size()), values);
+    gradients = &estimate;
+  }
+  const auto& g = *gradients;
+
+  const detail::interpolation_mesh<Triangles> mesh{points, triangles,
+                                                   adjacency};
+  detail::for_each_span(
+      mesh, grid,
+      [&](size_t, size_t t, size_t row, size_t first, size_t last,
+          const std::array<float, 3>& l0, const std::array<float, 3>& dl) {
+        const auto& w = triangles[t];
+        const float32x2 p[3] = {points[w[0]], points[w[1]], points[w[2]]};
+        const float f[3] = {values[w[0]], values[w[1]], values[w[2]]};
+        const auto c = (1.0f / 3) * (p[0] + p[1] + p[2]);
+
+        // e[i][j] lies on the edge from vertex i to vertex j next to i
+        // and a[i] on the segment from vertex i to the centroid.
+        float e[3][3], a[3];
+        for (size_t i = 0; i < 3; ++i) {
+          for (size_t j = 0; j < 3; ++j)
+            e[i][j] = f[i] + dot(g[w[i]], p[j] - p[i]) / 3;
+          a[i] = f[i] + dot(g[w[i]], c - p[i]) / 3;
+        }
+        // The interior point of the subtriangle opposite to vertex k
+        // makes the derivative in the edge normal direction linear.
+        float b[3];
+        for (size_t k = 0; k < 3; ++k) {
+          const auto i = (k + 1) % 3;
+          const auto j = (k + 2) % 3;
+          const auto edge = p[j] - p[i];
+          const auto dv = -dot(c - p[i], edge) / dot(edge, edge);
+          const auto du = -1 - dv;
+          const auto n0 = du * f[i] + dv * e[i][j] + a[i];
+          const auto n2 = du * e[j][i] + dv * f[j] + a[j];
+          b[k] = (n0 + n2) / 2 - du * e[i][j] - dv * e[j][i];
+        }
+        float d[3];
+        for (size_t i = 0; i < 3; ++i)
+          d[i] = (a[i] + b[(i + 1) % 3] + b[(i + 2) % 3]) / 3;
+        const auto center = (d[0] + d[1] + d[2]) / 3;
+
+        const auto out =
+            grid.data + row * grid.row_stride + first * grid.column_stride;
+        for (size_t n = 0; n < last - first; ++n) {
+          const float s = n;
+          const std::array<float, 3> l{l0[0] + s * dl[0], l0[1] + s * dl[1],
+                                       l0[2] + s * dl[2]};
+          // The subtriangle opposite to vertex k contains the cell if
+          // the barycentric coordinate of k is the smallest one.
+          const size_t k = (l[0] <= l[1]) ? ((l[0] <= l[2]) ? 0 : 2)
+                                          : ((l[1] <= l[2]) ? 1 : 2);
+          const auto i = (k + 1) % 3;
+          const auto j = (k + 2) % 3;
+          const auto u = l[i] - l[k];
+          const auto v = l[j] - l[k];
+          const auto x = 3 * l[k];
+          out[n * grid.column_stride] =
+              u * u * u * f[i] + v * v * v * f[j] + x * x * x * center +
+              3 * u * v * (u * e[i][j] + v * e[j][i]) +
+              3 * x * (u * u * a[i] + v * v * a[j]) +
+              3 * x * x * (u * d[i] + v * d[j]) + 6 * u * v * x * b[k];
+        }
+      });
+}
+
+}  // namespace lyrahgames::delaunay
@@ -0,0 +1,483 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+//
+#include <lyrahgames/delaunay/connectivity.hpp>
+#include <lyrahgames/delaunay/geometry.hpp>
+#include <lyrahgames/delaunay/guibas_stolfi.hpp>
+#include <lyrahgames/delaunay/hilbert.hpp>
+#include <lyrahgames/delaunay/parallel.hpp>
+#include <lyrahgames/delaunay/quad_edge.hpp>
+#include <lyrahgames/delaunay/statistics.hpp>
+
+namespace lyrahgames::delaunay::lawson {
+
+// Incremental Delaunay triangulation by Lawson's flip algorithm on the
+// index based quad-edge algebra. A new point splits the triangle it is
+// located in and the edges of the triangle are pushed to a flip stack.
+// Every popped edge whose quadrilateral violates the empty circle property
+// is swapped and the two edges behind it are pushed in turn.
+// Because edges are referenced by indices, the subdivision is independent
+// of its memory location. With 32-bit indices, the edges of a point
+// take about half of the memory of the pointer based engine.
+// An existing triangle mesh can be imported instead and its edges are
+// flipped in parallel rounds until the mesh is Delaunay. Its connectivity
+// is kept apart from the flips and nearly Delaunay meshes only pay
+// for the few flips they need.
+
+using point = float32x2;
+using triangle = std::array<size_t, 3>;
+
+using guibas_stolfi::inside_circumcircle;
+
+// Planar subdivision whose primal edges store the index of their origin
+// in 'points'. Dual edges store whether their origin face lies outside
+// of the triangulation, like the outer face of the super triangle or
+// the holes of an imported mesh.
+template <typename Index = uint32_t>
+struct subdivision {
+  using algebra = basic_quad_edge_algebra<Index>;
+  static constexpr Index outside = 1;
+
+  // Largest number of vertices whose triangulation can be addressed.
+  // A triangulation of n vertices has less than 3n edges and
+  // every edge takes four indices.
+  static constexpr size_t max_vertices() noexcept {
+    return std::numeric_limits<Index>::max() / 12;
+  }
+
+  bool right_of(const point& x, Index e) const noexcept {
+    return counterclockwise(x, points[diagram.destination(e)],
+                            points[diagram.origin(e)]);
+  }
+
+  // Checks if x equals the origin or destination of e.
+  bool coincides(const point& x, Index e) const noexcept {
+    const auto& o = points[diagram.origin(e)];
+    const auto& d = points[diagram.destination(e)];
+    return ((x[0] == o[0]) && (x[1] == o[1])) ||
+           ((x[0] == d[0]) && (x[1] == d[1]));
+  }
+
+  // Connects the first three points to a counterclockwise triangle.
+  void set_super_triangle() {
+    const auto u = diagram.new_edge();
+    diagram.origin(u) = 0;
+    diagram.destination(u) = 1;
+    const auto v = diagram.new_edge();
+    diagram.origin(v) = 1;
+    diagram.destination(v) = 2;
+    diagram.splice(diagram.sym(u), v);
+    const auto t = diagram.new_edge();
+    diagram.origin(t) = 2;
+    diagram.destination(t) = 0;
+    diagram.splice(diagram.sym(v), t);
+    diagram.splice(diagram.sym(t), u);
+    for (auto e : {u, v, t}) diagram.left(diagram.sym(e)) = outside;
+    hint = u;
+  }
+
+  // Replaces the subdivision by the given counterclockwise triangles of
+  // 'points'. Every edge has to be shared by at most two triangles with
+  // opposite orientation and the triangles around a vertex have to form
+  // a disk or a single fan. Faces not covered by triangles are outside.
+  template <typename Triangles>
+  void import(const Triangles& triangles) {
+    constexpr auto none = std::numeric_limits<Index>::max();
+    const auto n = points.size();
+    const auto m = triangles.size();
+    if ((n >= none) || (m > max_vertices()))
+      throw std::length_error("Too many triangles for the edge index type.");
+
+    // Half-edge h = 3t + k goes from vertex k to vertex k + 1 of triangle t.
+    // The half-edges are bucketed by their smaller vertex, such that
+    // the halves of an edge are found in a short bucket.
+    const auto origin = [&](size_t h) -> size_t {
+      return triangles[h / 3][h % 3];
+    };
+    const auto destination = [&](size_t h) -> size_t {
+      return triangles[h / 3][(h + 1) % 3];
+    };
+    std::vector<size_t> offsets(n + 1, 0);
+    for (size_t h = 0; h < 3 * m; ++h) {
+      const auto a = origin(h), b = destination(h);
+      if ((a >= n) || (b >= n) || (a == b))
+        throw std::invalid_argument("Triangle has invalid vertices.");
+      ++offsets[std::min(a, b) + 1];
+    }
+    for (size_t v = 0; v < n; ++v) offsets[v + 1] += offsets[v];
+    std::vector<size_t> halves(3 * m);
+    {
+      std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+      for (size_t h = 0; h < 3 * m; ++h)
+        halves[fill[std::min(origin(h), destination(h))]++] = h;
+    }
+
+    // Every edge gets a quad-edge. The half-edges of triangles map to
+    // its primal edges and the missing halves of boundary edges have
+    // the outside on their left.
+    diagram.edges.clear();
+    diagram.edges.reserve(12 * m);
+    std::vector<Index> record(3 * m);
+    std::vector<Index> boundary(n, none);
+    std::vector<Index> missing{};
+    for (size_t v = 0; v < n; ++v) {
+      const auto first = halves.begin() + offsets[v];
+      const auto last = halves.begin() + offsets[v + 1];
+      const auto other = [&](size_t h) {
+        return origin(h) + destination(h) - v;
+      };
+      std::sort(first, last, [&](size_t g, size_t h) {
+        return other(g) < other(h);
+      });
+      for (auto it = first; it != last;) {
+        const auto h = *it++;
+        const auto e = diagram.new_edge();
+        diagram.origin(e) = Index(origin(h));
+        diagram.destination(e) = Index(destination(h));
+        record[h] = e;
+        if ((it != last) && (other(*it) == other(h))) {
+          const auto g = *it++;
+          if ((origin(g) == origin(h)) ||
+              ((it != last) && (other(*it) == other(h))))
+            throw std::invalid_argument("Edge is not manifold.");
+          record[g] = diagram.sym(e);
+          continue;
+        }
+        if (boundary[origin(h)] != none)
+          throw std::invalid_argument("Vertex is not manifold.");
+        boundary[origin(h)] = e;
+        missing.push_back(diagram.sym(e));
+      }
+    }
+
+    // Around the origin of a half-edge, the next edge counterclockwise is
+    // the reversed previous half-edge of its triangle. A missing half
+    // is followed by the boundary half-edge leaving its origin.
+    for (size_t h = 0; h < 3 * m; ++h)
+      diagram.edges[record[h]].next =
+          diagram.sym(record[3 * (h / 3) + (h + 2) % 3]);
+    for (auto e : missing) {
+      const auto next = boundary[diagram.origin(e)];
+      if (next == none) throw std::invalid_argument("Vertex is not manifold.");
+      diagram.edges[e].next = next;
+      diagram.left(e) = outside;
+    }
+
+    // The rings of the dual edges follow the faces. With lnext(e) being
+    // oprev(sym(e)), the dual ring is given by the inverse primal rings.
+    std::vector<Index> previous(diagram.edges.size());
+    for (Index e = 0; e < diagram.edges.size(); e += 2)
+      previous[diagram.onext(e)] = e;
+    for (Index e = 0; e < diagram.edges.size(); e += 2)
+      diagram.edges[diagram.rotr(e)].next =
+          diagram.rotr(previous[diagram.sym(e)]);
+    hint = 0;
+  }
+
+  // Walks from the last inserted edge to an edge whose left face
+  // contains x or whose origin or destination coincides with x.
+  template <typename Statistics = no_statistics>
+  Index locate(const point& x, Statistics&& statistics = {}) const noexcept {
+    const auto right_of_x = [&](Index e) {
+      statistics.test_orientation();
+      return right_of(x, e);
+    };
+    auto e = hint;
+    size_t steps = 0;
+    for (;; ++steps) {
+      // For an already inserted point, the walk would cycle around it.
+      if (coincides(x, e))
+        break;
+      else if (right_of_x(e))
+        e = diagram.sym(e);
+      else if (!right_of_x(diagram.onext(e)))
+        e = diagram.onext(e);
+      else if (!right_of_x(diagram.dprev(e)))
+        e = diagram.dprev(e);
+      else
+        break;
+    }
+    statistics.walk(steps);
+    return e;
+  }
+
+  // Checks if the apex of the left triangle of e lies inside the
+  // circumcircle of its right triangle. Edges at the outside and edges
+  // whose quadrilateral is not strictly convex cannot be swapped.
+  bool illegal(Index e) const noexcept {
+    if ((diagram.left(e) == outside) || (diagram.right(e) == outside))
+      return false;
+    const auto& o = points[diagram.origin(e)];
+    const auto& d = points[diagram.destination(e)];
+    const auto& r = points[diagram.destination(diagram.oprev(e))];
+    const auto& l = points[diagram.destination(diagram.lnext(e))];
+    return counterclockwise(r, l, o) && counterclockwise(l, r, d) &&
+           inside_circumcircle(o, r, d, l);
+  }
+
+  // Swaps the edge e if it is illegal.
+  template <typename Statistics = no_statistics>
+  bool legalize(Index e, Statistics&& statistics = {}) noexcept {
+    statistics.test_orientation(2);
+    statistics.test_incircle();
+    if (!illegal(e)) return false;
+    statistics.flip();
+    diagram.swap(e);
+    return true;
+  }
+
+  // Pops and legalizes edges until the flip stack is empty. After a swap,
+  // the edge connects the two apices and the two edges of the right
+  // triangle opposite to the left apex may have become illegal.
+  template <typename Statistics = no_statistics>
+  void flip(Statistics&& statistics = {}) {
+    while (!stack.empty()) {
+      const auto e = stack.back();
+      stack.pop_back();
+      if (!legalize(e, statistics)) continue;
+      stack.push_back(diagram.lprev(e));
+      stack.push_back(diagram.lnext(diagram.sym(e)));
+    }
+  }
+
+  // Inserts the vertex v and restores the Delaunay property.
+  // Returns false and leaves the subdivision unchanged for duplicates.
+  // A point on an edge creates a degenerate triangle which is removed
+  // by the first flip of that edge.
+  template <typename Statistics = no_statistics>
+  bool insert(Index v, Statistics&& statistics = {}) {
+    const auto& x = points[v];
+    auto e = locate(x, statistics);
+    if (coincides(x, e)) {
+      statistics.skip_duplicate();
+      return false;
+    }
+    statistics.insert();
+    auto base = diagram.new_edge();
+    diagram.origin(base) = diagram.origin(e);
+    diagram.destination(base) = v;
+    diagram.splice(base, e);
+    const auto first = base;
+    do {
+      base = diagram.connection(e, diagram.sym(base));
+      e = diagram.oprev(base);
+    } while (diagram.lnext(e) != first);
+
+    // The edges around v bound triangles whose third edge is in the link.
+    const auto spoke = diagram.sym(first);
+    auto s = spoke;
+    do {
+      stack.push_back(diagram.lnext(s));
+      s = diagram.onext(s);
+    } while (s != spoke);
+    flip(statistics);
+    hint = first;
+    return true;
+  }
+
+  // Legalizes all edges until the triangulation is Delaunay.
+  // The flips are processed in rounds. In every round, the illegal edges
+  // claim the four vertices of their quadrilateral in parallel and
+  // the edges holding all of their claims are swapped in parallel.
+  // Their quadrilaterals share no vertex and so no edge. Claims are
+  // decided by a random key which is a bijection of the edge index.
+  // Every vertex keeps the smallest key claiming it. So the edge with the
+  // lowest key always wins and neighboring chains of illegal edges do not
+  // serialize the flips like an order by index would. A vertex holding
+  // 'none' is unclaimed. So the single edge whose key equals 'none' only
+  // wins vertices that no other edge claims. Losers and the edges around
+  // swapped ones form the next round.
+  template <typename Statistics = no_statistics>
+  void flip_all(Statistics&& statistics = {}) {
+    constexpr auto none = std::numeric_limits<Index>::max();
+    const auto edge_count = diagram.edges.size() / 4;
+    std::vector<Index> queue(edge_count);
+    for (size_t i = 0; i < edge_count; ++i) queue[i] = Index(4 * i);
+    std::vector<char> queued(edge_count, true);
+    std::vector<std::atomic<Index>> claims(points.size());
+    for (auto& c : claims) c.store(none, std::memory_order_relaxed);
+
+    // Illegal edges store their quadrilateral and are blocked until
+    // they win all of their claims.
+    enum : char { legal, blocked, swapped };
+    std::vector<char> state{};
+    std::vector<std::array<Index, 4>> quads{};
+    std::vector<Index> next{};
+    for (uint64_t round = 0; !queue.empty(); ++round) {
+      // Multiplications by odd numbers and xor shifts are invertible.
+      constexpr auto bits = 8 * sizeof(Index);
+      const auto seed = Index(round * 0x9e3779b97f4a7c15);
+      const auto priority = [seed](Index e) {
+        auto x = Index(uint64_t(Index(e ^ seed)) * 0xff51afd7ed558ccd);
+        x ^= x >> (bits / 2);
+        return Index(uint64_t(x) * 0xc4ceb9fe1a85ec53);
+      };
+      const auto threads = thread_count(queue.size());
+      state.assign(queue.size(), legal);
+      quads.resize(queue.size());
+      parallel_for(queue.size(), threads, [&](size_t, size_t first,
+                                              size_t last) {
+        const auto claim = [](std::atomic<Index>& c, Index key) {
+          auto current = c.load(std::memory_order_relaxed);
+          while ((key < current) &&
+                 !c.compare_exchange_weak(current, key,
+                                          std::memory_order_relaxed)) {
+          }
+        };
+        for (auto i = first; i < last; ++i) {
+          const auto e = queue[i];
+          if (!illegal(e)) continue;
+          state[i] = blocked;
+          quads[i] = {diagram.origin(e), diagram.destination(e),
+                      diagram.destination(diagram.oprev(e)),
+                      diagram.destination(diagram.lnext(e))};
+          for (auto v : quads[i]) claim(claims[v], priority(e));
+        }
+      });
+      // Winners are decided before any swap changes the edges of others.
+      parallel_for(queue.size(), threads, [&](size_t, size_t first,
+                                              size_t last) {
+        for (auto i = first; i < last; ++i) {
+          if (state[i] == legal) continue;
+          const auto key = priority(queue[i]);
+          bool won = true;
+          for (auto v : quads[i])
+            won &= (claims[v].load(std::memory_order_relaxed) == key);
+          if (won) state[i] = swapped;
+        }
+      });
+      parallel_for(queue.size(), threads, [&](size_t, size_t first,
+                                              size_t last) {
+        for (auto i = first; i < last; ++i)
+          if (state[i] == swapped) diagram.swap(queue[i]);
+      });
+
+      statistics.test_orientation(2 * queue.size());
+      statistics.test_incircle(queue.size());
+      for (auto e : queue) queued[e / 4] = false;
+      next.clear();
+      const auto push = [&](Index e) {
+        if (queued[e / 4]) return;
+        queued[e / 4] = true;
+        next.push_back(e & algebra::base_mask);
+      };
+      for (size_t i = 0; i < queue.size(); ++i) {
+        if (state[i] == legal) continue;
+        for (auto v : quads[i])
+          claims[v].store(none, std::memory_order_relaxed);
+        const auto e = queue[i];
+        if (state[i] == blocked) {
+          push(e);
+          continue;
+        }
+        statistics.flip();
+        push(diagram.lprev(e));
+        push(diagram.lnext(e));
+        push(diagram.lprev(diagram.sym(e)));
+        push(diagram.lnext(diagram.sym(e)));
+      }
+      std::swap(queue, next);
+    }
+  }
+
+  // Returns the counterclockwise triangles whose vertices are not less
+  // than 'first' as indices relative to 'first'.
+  auto triangles(size_t first = 0) const {
+    std::vector<triangle> result{};
+    for (size_t q = 0; q < diagram.edges.size(); q += 4) {
+      // Every face is reported by its primal edge with the lowest index.
+      for (auto e : {Index(q), Index(q + 2)}) {
+        const auto f = diagram.lnext(e);
+        const auto g = diagram.lnext(f);
+        if ((diagram.lnext(g) != e) || (f < e) || (g < e) ||
+            (diagram.left(e) == outside))
+          continue;
+        const triangle t{diagram.origin(e), diagram.origin(f),
+                         diagram.origin(g)};
+        if ((t[0] < first) || (t[1] < first) || (t[2] < first)) continue;
+        result.push_back({t[0] - first, t[1] - first, t[2] - first});
+      }
+    }
+    return result;
+  }
+
+  std::vector<point> points{};
+  algebra diagram{};
+  std::vector<Index> stack{};
+  Index hint{};
+};
+
+// Returns the counterclockwise Delaunay triangles of the given points.
+// Points are inserted in Hilbert order such that every walk starts next to
+// the new point. Duplicated points are skipped. Throws if the edges of the
+// triangulation cannot be addressed by the index type.
+// If the connectivity is requested, the neighbors of all triangles
+// and the triangles around each vertex are computed.
+// Events of the construction are reported to the statistics policy.
+template <typename Index = uint32_t, typename Statistics = no_statistics>
+std::vector<triangle> triangulation(const std::vector<point>& points,
+                                    connectivity<3>* adjacency = nullptr,
+                                    Statistics&& statistics = {}) {
+  const auto n = points.size();
+  if (n + 3 > subdivision<Index>::max_vertices())
+    throw std::length_error("Too many points for the edge index type.");
+  if (adjacency) adjacency->reset(n);
+  if (n < 3) return {};
+
+  const auto order = hilbert_order(points);
+  const auto super = bounding_triangle(bounding_circle(bounding_box(points)));
+  subdivision<Index> mesh{};
+  mesh.points.reserve(n + 3);
+  mesh.points.assign(super.begin(), super.end());
+  for (auto i : order) mesh.points.push_back(points[i]);
+  // Every insertion creates three edges and flips reuse them.
+  mesh.diagram.edges.reserve(4 * (3 * n + 3));
+  mesh.set_super_triangle();
+  for (size_t v = 3; v < n + 3; ++v) mesh.insert(Index(v), statistics);
+
+  auto result = mesh.triangles(3);
+  for (auto& t : result)
+    for (auto& v : t) v = order[v];
+  if (adjacency) {
+    for (const auto& t : result) adjacency->count(t);
+    adjacency->assemble(result);
+  }
+  return result;
+}
+
+// Flips the edges of the given counterclockwise triangles of the points
+// until every edge is locally Delaunay and returns the resulting triangles.
+// The triangles have to form a manifold mesh. Its boundary and holes are
+// kept and so a mesh of the convex hull becomes the Delaunay triangulation.
+// Vertex indices stay the ones of the input. Throws if the mesh is not
+// manifold or its edges cannot be addressed by the index type.
+// If the connectivity is requested, the neighbors of all triangles
+// and the triangles around each vertex are computed.
+// Events of the flips are reported to the statistics policy.
+template <typename Index = uint32_t, typename Statistics = no_statistics>
+std::vector<triangle> triangulation(const std::vector<point>& points,
+                                    const std::vector<triangle>& triangles,
+                                    connectivity<3>* adjacency = nullptr,
+                                    Statistics&& statistics = {}) {
+  subdivision<Index> mesh{};
+  mesh.points = points;
+  mesh.import(triangles);
+  mesh.flip_all(statistics);
+
+  auto result = mesh.triangles();
+  if (adjacency) {
+    adjacency->reset(points.size());
+    for (const auto& t : result) adjacency->count(t);
+    adjacency->assemble(result);
+  }
+  return result;
+}
+
+}  // namespace lyrahgames::delaunay::lawson
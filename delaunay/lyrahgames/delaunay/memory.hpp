@@ -0,0 +1,63 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+namespace lyrahgames::delaunay {
+
+struct memory_statistics {
+  size_t allocations{};
+  size_t deallocations{};
+  // Number of bytes that are currently allocated.
+  size_t bytes{};
+  // High-water mark of allocated bytes.
+  size_t peak_bytes{};
+  // Sum of all allocated bytes.
+  size_t total_bytes{};
+};
+
+// Memory statistics of all tracking allocators in the calling thread.
+// Reset them by assigning an empty object before running an engine.
+inline memory_statistics& memory_usage() noexcept {
+  thread_local memory_statistics statistics{};
+  return statistics;
+}
+
+// Stateless allocator that forwards to 'std::allocator' and records every
+// allocation in the memory statistics of the current thread.
+// It can be injected into the containers of all engines
+// by their 'Allocator' template parameter.
+// Memory has to be deallocated by the same thread it was allocated by.
+template <typename T>
+struct tracking_allocator {
+  using value_type = T;
+
+  tracking_allocator() noexcept = default;
+  template <typename U>
+  tracking_allocator(const tracking_allocator<U>&) noexcept {}
+
+  T* allocate(size_t n) {
+    const auto result = std::allocator<T>{}.allocate(n);
+    auto& usage = memory_usage();
+    ++usage.allocations;
+    usage.bytes += n * sizeof(T);
+    usage.total_bytes += n * sizeof(T);
+    usage.peak_bytes = std::max(usage.peak_bytes, usage.bytes);
+    return result;
+  }
+
+  void deallocate(T* p, size_t n) noexcept {
+    std::allocator<T>{}.deallocate(p, n);
+    auto& usage = memory_usage();
+    ++usage.deallocations;
+    usage.bytes -= n * sizeof(T);
+  }
+
+  template <typename U>
+  friend constexpr bool operator==(const tracking_allocator&,
+                                   const tracking_allocator<U>&) noexcept {
+    return true;
+  }
+};
+
+}  // namespace lyrahgames::delaunay
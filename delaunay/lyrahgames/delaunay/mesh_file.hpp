@@ -0,0 +1,428 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+//
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LYRAHGAMES_DELAUNAY_MMAP 1
+#endif
+//
+#include <lyrahgames/delaunay/connectivity.hpp>
+
+namespace lyrahgames::delaunay {
+
+// Binary mesh format, version 1
+//
+// All values are stored in little-endian byte order.
+// The file starts with a header of 128 bytes which is followed by sections
+// that are aligned to 64 bytes. Their offsets are stored in the header.
+// Points are stored as 32-bit floating-point coordinates and all indices
+// are stored as 64-bit unsigned integers. Boundary facets are marked
+// by the maximal index value in the neighbor section.
+//
+//   offset  size  content
+//        0     8  magic "LGDMESH\0"
+//        8     4  version
+//       12     4  byte order tag 0x01020304
+//       16     4  flags (bit 0: adjacency sections are present)
+//       20     4  dimension of points
+//       24     4  vertices per element
+//       28     4  reserved
+//       32     8  vertex count n
+//       40     8  element count m
+//       48     8  offset of points section          (n * dimension floats)
+//       56     8  offset of elements section        (m * K indices)
+//       64     8  offset of neighbors section       (m * K indices)
+//       72     8  offset of vertex offsets section  (n + 1 indices)
+//       80     8  offset of vertex elements section (m * K indices)
+//       88    40  reserved
+namespace mesh_file {
+
+constexpr char magic[8] = {'L', 'G', 'D', 'M', 'E', 'S', 'H', '\0'};
+constexpr uint32_t version = 1;
+constexpr uint32_t byte_order_tag = 0x01020304;
+constexpr uint32_t adjacency_flag = 0b1;
+constexpr size_t header_size = 128;
+constexpr size_t alignment = 64;
+
+struct header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t flags;
+  uint32_t dimension;
+  uint32_t element_size;
+  uint32_t reserved0;
+  uint64_t vertex_count;
+  uint64_t element_count;
+  uint64_t points;
+  uint64_t elements;
+  uint64_t neighbors;
+  uint64_t vertex_offsets;
+  uint64_t vertex_elements;
+  uint64_t reserved1[5];
+};
+
+static_assert(sizeof(header) == header_size);
+static_assert(std::is_trivially_copyable_v<header>);
+
+constexpr auto aligned(uint64_t offset) noexcept {
+  return (offset + alignment - 1) & ~uint64_t{alignment - 1};
+}
+
+inline bool little_endian() noexcept {
+  const uint32_t x = 1;
+  unsigned char c;
+  std::memcpy(&c, &x, 1);
+  return c == 1;
+}
+
+template <typename T>
+inline T byte_swap(T x) noexcept {
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, &x, sizeof(T));
+  for (size_t i = 0; i < sizeof(T) / 2; ++i)
+    std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+  std::memcpy(&x, bytes, sizeof(T));
+  return x;
+}
+
+// The header consists of naturally aligned 32-bit and 64-bit fields only.
+// So its byte order can be changed field by field.
+inline header byte_swap(header h) noexcept {
+  for (auto x : {&h.version, &h.byte_order, &h.flags, &h.dimension,
+                 &h.element_size, &h.reserved0})
+    *x = byte_swap(*x);
+  for (auto x : {&h.vertex_count, &h.element_count, &h.points, &h.elements,
+                 &h.neighbors, &h.vertex_offsets, &h.vertex_elements})
+    *x = byte_swap(*x);
+  return h;
+}
+
+// Writes an array of 32-bit or 64-bit values in little-endian byte order.
+template <typename T>
+inline void write(std::ofstream& file, const T* data, size_t count) {
+  if (little_endian()) {
+    file.write(reinterpret_cast<const char*>(data), count * sizeof(T));
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const auto x = byte_swap(data[i]);
+    file.write(reinterpret_cast<const char*>(&x), sizeof(T));
+  }
+}
+
+inline void pad(std::ofstream& file, uint64_t offset) {
+  static constexpr char zeros[alignment]{};
+  const auto size = static_cast<uint64_t>(file.tellp());
+  file.write(zeros, offset - size);
+}
+
+// Contiguous read-only range of values inside a mapped file.
+template <typename T>
+struct view {
+  const T* begin() const noexcept { return data; }
+  const T* end() const noexcept { return data + count; }
+  const T& operator[](size_t index) const noexcept { return data[index]; }
+  size_t size() const noexcept { return count; }
+  bool empty() const noexcept { return count == 0; }
+
+  const T* data{};
+  size_t count{};
+};
+
+template <typename Element, size_t K, size_t... I>
+inline void emplace_back(std::vector<Element>& elements,
+                         const std::array<size_t, K>& e,
+                         std::index_sequence<I...>) {
+  elements.emplace_back(e[I]...);
+}
+
+}  // namespace mesh_file
+
+// Stores points, elements and, optionally, the connectivity in the binary
+// mesh format. The point type has to consist of 32-bit floating-point
+// coordinates. Elements are arrays of 'size_t' vertex indices.
+template <typename Point, typename Element, size_t K>
+void save(const std::string& path, const std::vector<Point>& points,
+          const std::vector<Element>& elements,
+          const connectivity<K>* adjacency) {
+  static_assert(std::is_trivially_copyable_v<Point> &&
+                (sizeof(Point) % sizeof(float) == 0));
+  static_assert(sizeof(Element) == K * sizeof(size_t));
+  static_assert(sizeof(size_t) == sizeof(uint64_t));
+
+  const uint64_t n = points.size();
+  const uint64_t m = elements.size();
+  const uint32_t dimension = sizeof(Point) / sizeof(float);
+
+  mesh_file::header h{};
+  std::memcpy(h.magic, mesh_file::magic, sizeof(h.magic));
+  h.version = mesh_file::version;
+  h.byte_order = mesh_file::byte_order_tag;
+  h.flags = adjacency ? mesh_file::adjacency_flag : 0;
+  h.dimension = dimension;
+  h.element_size = K;
+  h.vertex_count = n;
+  h.element_count = m;
+  h.points = mesh_file::aligned(mesh_file::header_size);
+  h.elements = mesh_file::aligned(h.points + n * dimension * sizeof(float));
+  auto end = h.elements + m * K * sizeof(uint64_t);
+  if (adjacency) {
+    h.neighbors = mesh_file::aligned(end);
+    h.vertex_offsets =
+        mesh_file::aligned(h.neighbors + m * K * sizeof(uint64_t));
+    h.vertex_elements =
+        mesh_file::aligned(h.vertex_offsets + (n + 1) * sizeof(uint64_t));
+  }
+
+  std::ofstream file{path, std::ios::binary};
+  if (!file) throw std::runtime_error("Failed to open '" + path + "'.");
+
+  const auto stored = mesh_file::little_endian() ? h : mesh_file::byte_swap(h);
+  file.write(reinterpret_cast<const char*>(&stored), sizeof(stored));
+
+  mesh_file::pad(file, h.points);
+  mesh_file::write(file, reinterpret_cast<const float*>(points.data()),
+                   n * dimension);
+  mesh_file::pad(file, h.elements);
+  mesh_file::write(file, reinterpret_cast<const uint64_t*>(elements.data()),
+                   m * K);
+  if (adjacency) {
+    mesh_file::pad(file, h.neighbors);
+    mesh_file::write(
+        file, reinterpret_cast<const uint64_t*>(adjacency->neighbors.data()),
+        m * K);
+    mesh_file::pad(file, h.vertex_offsets);
+    mesh_file::write(file,
+                     reinterpret_cast<const uint64_t*>(
+                         adjacency->vertex_offsets.data()),
+                     n + 1);
+    mesh_file::pad(file, h.vertex_elements);
+    mesh_file::write(file,
+                     reinterpret_cast<const uint64_t*>(
+                         adjacency->vertex_elements.data()),
+                     m * K);
+  }
+  if (!file) throw std::runtime_error("Failed to write '" + path + "'.");
+}
+
+template <typename Point, typename Element>
+void save(const std::string& path, const std::vector<Point>& points,
+          const std::vector<Element>& elements) {
+  constexpr size_t K = sizeof(Element) / sizeof(size_t);
+  save<Point, Element, K>(path, points, elements, nullptr);
+}
+
+// Read-only view of a mesh file.
+// On POSIX systems, the file is memory-mapped and no data is copied.
+// Apart from checking the header, loading does not touch the sections.
+// The returned views stay valid as long as the mapped mesh exists.
+class mapped_mesh {
+ public:
+  explicit mapped_mesh(const std::string& path) {
+#ifdef LYRAHGAMES_DELAUNAY_MMAP
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Failed to open '" + path + "'.");
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+      ::close(fd);
+      throw std::runtime_error("Failed to query '" + path + "'.");
+    }
+    size = static_cast<size_t>(info.st_size);
+    if (size > 0) {
+      auto address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Failed to map '" + path + "'.");
+      }
+      data = static_cast<const char*>(address);
+    }
+    ::close(fd);
+#else
+    std::ifstream file{path, std::ios::binary | std::ios::ate};
+    if (!file) throw std::runtime_error("Failed to open '" + path + "'.");
+    size = static_cast<size_t>(file.tellg());
+    buffer.resize((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(buffer.data()), size);
+    data = reinterpret_cast<const char*>(buffer.data());
+#endif
+    try {
+      validate();
+    } catch (...) {
+      release();
+      throw;
+    }
+  }
+
+  mapped_mesh(const mapped_mesh&) = delete;
+  mapped_mesh& operator=(const mapped_mesh&) = delete;
+
+  mapped_mesh(mapped_mesh&& other) noexcept
+      : data{std::exchange(other.data, nullptr)},
+        size{std::exchange(other.size, 0)},
+        h{other.h},
+        buffer{std::move(other.buffer)} {}
+
+  mapped_mesh& operator=(mapped_mesh&& other) noexcept {
+    std::swap(data, other.data);
+    std::swap(size, other.size);
+    std::swap(h, other.h);
+    std::swap(buffer, other.buffer);
+    return *this;
+  }
+
+  ~mapped_mesh() { release(); }
+
+  size_t dimension() const noexcept { return h.dimension; }
+  size_t element_size() const noexcept { return h.element_size; }
+  size_t vertex_count() const noexcept { return h.vertex_count; }
+  size_t element_count() const noexcept { return h.element_count; }
+  bool has_adjacency() const noexcept {
+    return h.flags & mesh_file::adjacency_flag;
+  }
+
+  template <typename Point>
+  auto points() const {
+    static_assert(std::is_trivially_copyable_v<Point>);
+    if (sizeof(Point) != h.dimension * sizeof(float))
+      throw std::invalid_argument("Point type does not match dimension.");
+    return section<Point>(h.points, h.vertex_count);
+  }
+
+  template <size_t K>
+  auto elements() const {
+    check_element_size(K);
+    return section<std::array<size_t, K>>(h.elements, h.element_count);
+  }
+
+  template <size_t K>
+  auto neighbors() const {
+    check_element_size(K);
+    check_adjacency();
+    return section<std::array<size_t, K>>(h.neighbors, h.element_count);
+  }
+
+  mesh_file::view<size_t> vertex_offsets() const {
+    check_adjacency();
+    return section<size_t>(h.vertex_offsets, h.vertex_count + 1);
+  }
+
+  mesh_file::view<size_t> vertex_elements() const {
+    check_adjacency();
+    return section<size_t>(h.vertex_elements,
+                           h.element_count * h.element_size);
+  }
+
+ private:
+  void validate() {
+    if (!mesh_file::little_endian())
+      throw std::runtime_error(
+          "Mesh files can only be mapped on little-endian systems.");
+    if (size < mesh_file::header_size)
+      throw std::runtime_error("Mesh file is too small.");
+    std::memcpy(&h, data, sizeof(h));
+    if (std::memcmp(h.magic, mesh_file::magic, sizeof(h.magic)) != 0)
+      throw std::runtime_error("File is not a mesh file.");
+    if (h.version != mesh_file::version)
+      throw std::runtime_error("Unsupported mesh file version.");
+    if (h.byte_order != mesh_file::byte_order_tag)
+      throw std::runtime_error("Mesh file has wrong byte order.");
+
+    if ((h.dimension == 0) || (h.element_size == 0))
+      throw std::runtime_error("Mesh file has invalid sizes.");
+
+    // The counts are not trusted. So the sections are checked by dividing
+    // the available bytes and no product of the counts can wrap around.
+    // Because the points take at least four bytes each, n + 1 cannot
+    // wrap around after the points have been checked.
+    const auto n = h.vertex_count;
+    const auto m = h.element_count;
+    const auto point_bytes = uint64_t{h.dimension} * sizeof(float);
+    const auto element_bytes = uint64_t{h.element_size} * sizeof(uint64_t);
+    bool valid = fits(h.points, n, point_bytes) &&
+                 fits(h.elements, m, element_bytes);
+    if (has_adjacency())
+      valid = valid && fits(h.neighbors, m, element_bytes) &&
+              fits(h.vertex_offsets, n + 1, sizeof(uint64_t)) &&
+              fits(h.vertex_elements, m, element_bytes);
+    if (!valid) throw std::runtime_error("Mesh file is truncated.");
+  }
+
+  // Checks if 'count' values of 'stride' bytes fit behind the offset.
+  bool fits(uint64_t offset, uint64_t count, uint64_t stride) const noexcept {
+    return (offset % mesh_file::alignment == 0) && (offset <= size) &&
+           (count <= (size - offset) / stride);
+  }
+
+  void check_element_size(size_t k) const {
+    if (k != h.element_size)
+      throw std::invalid_argument("Element size does not match.");
+  }
+
+  void check_adjacency() const {
+    if (!has_adjacency())
+      throw std::logic_error("Mesh file does not contain adjacency.");
+  }
+
+  template <typename T>
+  mesh_file::view<T> section(uint64_t offset, uint64_t count) const noexcept {
+    return mesh_file::view<T>{reinterpret_cast<const T*>(data + offset),
+                              static_cast<size_t>(count)};
+  }
+
+  void release() noexcept {
+#ifdef LYRAHGAMES_DELAUNAY_MMAP
+    if (data) ::munmap(const_cast<char*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+  }
+
+  const char* data{};
+  size_t size{};
+  mesh_file::header h{};
+  std::vector<uint64_t> buffer{};
+};
+
+// Copies the content of a mapped mesh into containers
+// that can be passed on to algorithms needing ownership.
+template <typename Point, typename Element>
+void load(const mapped_mesh& mesh, std::vector<Point>& points,
+          std::vector<Element>& elements) {
+  constexpr size_t K = sizeof(Element) / sizeof(size_t);
+  static_assert(sizeof(Element) == K * sizeof(size_t));
+  const auto p = mesh.points<Point>();
+  points.assign(p.begin(), p.end());
+  const auto e = mesh.elements<K>();
+  elements.clear();
+  elements.reserve(e.size());
+  for (const auto& x : e)
+    mesh_file::emplace_back(elements, x, std::make_index_sequence<K>{});
+}
+
+template <typename Point, typename Element, size_t K>
+void load(const mapped_mesh& mesh, std::vector<Point>& points,
+          std::vector<Element>& elements, connectivity<K>& adjacency) {
+  static_assert(sizeof(Element) == K * sizeof(size_t));
+  load(mesh, points, elements);
+  const auto n = mesh.neighbors<K>();
+  adjacency.neighbors.assign(n.begin(), n.end());
+  const auto o = mesh.vertex_offsets();
+  adjacency.vertex_offsets.assign(o.begin(), o.end());
+  const auto v = mesh.vertex_elements();
+  adjacency.vertex_elements.assign(v.begin(), v.end());
+}
+
+}  // namespace lyrahgames::delaunay
@@ -0,0 +1,43 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace lyrahgames::delaunay {
+
+// Returns the number of threads to use for n work items
+// such that every thread gets at least 'grain' items.
+inline size_t thread_count(size_t n, size_t grain = size_t{1} << 12) noexcept {
+  const size_t hardware =
+      std::max<size_t>(1, std::thread::hardware_concurrency());
+  return std::max<size_t>(1, std::min(hardware, n / grain));
+}
+
+// Splits the range [0, n) into contiguous chunks, one for every thread,
+// and calls f(thread, first, last) for each of them.
+// The chunks only depend on n and the thread count. So calling
+// this function twice with the same arguments yields the same partition.
+template <typename Functor>
+void parallel_for(size_t n, size_t threads, Functor&& f) {
+  if (threads <= 1) {
+    f(size_t{0}, size_t{0}, n);
+    return;
+  }
+  std::vector<std::thread> workers{};
+  workers.reserve(threads - 1);
+  for (size_t t = 1; t < threads; ++t)
+    workers.emplace_back([&f, t, n, threads] {
+      f(t, t * n / threads, (t + 1) * n / threads);
+    });
+  f(size_t{0}, size_t{0}, n / threads);
+  for (auto& worker : workers) worker.join();
+}
+
+template <typename Functor>
+void parallel_for(size_t n, Functor&& f) {
+  parallel_for(n, thread_count(n), std::forward<Functor>(f));
+}
+
+}  // namespace lyrahgames::delaunay
@@ -0,0 +1,573 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+//
+#include <lyrahgames/delaunay/cavity.hpp>
+#include <lyrahgames/delaunay/hilbert.hpp>
+#include <lyrahgames/delaunay/statistics.hpp>
+
+namespace lyrahgames::delaunay::periodic {
+
+// Delaunay triangulations of points in a box whose opposite sides are
+// identified, like in periodic simulation boxes. Instead of replicating
+// the points, every vertex of an element carries the lattice offset of its
+// image, measured in periods of the box. Every element is stored once and
+// the offset of its first vertex is zero. The other offsets are relative
+// to it and are applied on the fly when evaluating the predicates.
+//
+// Like on the torus, an insertion only affects the elements whose
+// circumsphere contains an image of the new point. As long as every
+// circumsphere is smaller than the shortest period, this is at most one
+// image for every element and the cavities of different images are disjoint.
+// Empty spheres can only shrink by insertions. So the property is only
+// established once. A random sample of the points is triangulated in the
+// covering space of 3^N copies of the box by the same algorithm. If the
+// elements of the central copy form a closed triangulation of the box whose
+// circumspheres are small enough, the remaining points are inserted by the
+// Bowyer-Watson algorithm. Otherwise, the sample is doubled. For point sets
+// that are too sparse, an exception is thrown.
+
+template <size_t N>
+using offset = std::array<int, N>;
+
+// Element given by the indices of its vertices and their lattice offsets.
+// Triangles are counterclockwise and tetrahedra are positively oriented.
+template <size_t N>
+struct element {
+  std::array<size_t, N + 1> vertices{};
+  std::array<offset<N>, N + 1> offsets{};
+};
+
+using triangle = element<2>;
+using tetrahedron = element<3>;
+
+// Box of the fundamental domain. All points have to lie inside
+// the half-open box [min, max).
+template <size_t N>
+struct domain {
+  std::array<double, N> min{};
+  std::array<double, N> max{};
+};
+
+namespace detail {
+
+template <size_t N>
+using real = std::array<double, N>;
+
+template <size_t N>
+auto image(const real<N>& x, const offset<N>& o, const real<N>& period) {
+  auto result = x;
+  for (size_t k = 0; k < N; ++k) result[k] += o[k] * period[k];
+  return result;
+}
+
+// Positive if the vertices are counterclockwise or positively oriented.
+template <size_t N>
+double orientation(const std::array<real<N>, N + 1>& v) noexcept {
+  const auto& a = v[0];
+  if constexpr (N == 2) {
+    return (v[1][0] - a[0]) * (v[2][1] - a[1]) -
+           (v[1][1] - a[1]) * (v[2][0] - a[0]);
+  } else {
+    real<3> u{}, w{}, x{};
+    for (size_t k = 0; k < 3; ++k) {
+      u[k] = v[1][k] - a[k];
+      w[k] = v[2][k] - a[k];
+      x[k] = v[3][k] - a[k];
+    }
+    return (u[1] * w[2] - u[2] * w[1]) * x[0] +
+           (u[2] * w[0] - u[0] * w[2]) * x[1] +
+           (u[0] * w[1] - u[1] * w[0]) * x[2];
+  }
+}
+
+// Positive if p lies inside the circumsphere of the positively oriented
+// element with the given vertices.
+template <size_t N>
+double insphere(const std::array<real<N>, N + 1>& v,
+                const real<N>& p) noexcept {
+  std::array<std::array<double, N + 1>, N + 1> m{};
+  for (size_t i = 0; i <= N; ++i) {
+    double l = 0;
+    for (size_t k = 0; k < N; ++k) {
+      m[i][k] = v[i][k] - p[k];
+      l += m[i][k] * m[i][k];
+    }
+    m[i][N] = l;
+  }
+  if constexpr (N == 2) {
+    return m[0][2] * (m[1][0] * m[2][1] - m[2][0] * m[1][1]) -
+           m[1][2] * (m[0][0] * m[2][1] - m[2][0] * m[0][1]) +
+           m[2][2] * (m[0][0] * m[1][1] - m[1][0] * m[0][1]);
+  } else {
+    const auto& [ax, ay, az, al] = m[0];
+    const auto& [bx, by, bz, bl] = m[1];
+    const auto& [cx, cy, cz, cl] = m[2];
+    const auto& [dx, dy, dz, dl] = m[3];
+    const auto ab = ax * by - bx * ay;
+    const auto bc = bx * cy - cx * by;
+    const auto cd = cx * dy - dx * cy;
+    const auto da = dx * ay - ax * dy;
+    const auto ac = ax * cy - cx * ay;
+    const auto bd = bx * dy - dx * by;
+    const auto abc = az * bc - bz * ac + cz * ab;
+    const auto bcd = bz * cd - cz * bd + dz * bc;
+    const auto cda = cz * da + dz * ac + az * cd;
+    const auto dab = dz * ab + az * bd + bz * da;
+    return (al * bcd - bl * cda) + (cl * dab - dl * abc);
+  }
+}
+
+// Center and squared radius of the circumsphere.
+template <size_t N>
+auto circumsphere(const std::array<real<N>, N + 1>& v) noexcept {
+  // Solve 2 (v_i - v_0) m = |v_i - v_0|^2 by Cramer's rule.
+  std::array<real<N>, N> u{};
+  real<N> l{};
+  for (size_t i = 0; i < N; ++i)
+    for (size_t k = 0; k < N; ++k) {
+      u[i][k] = v[i + 1][k] - v[0][k];
+      l[i] += u[i][k] * u[i][k];
+    }
+  real<N> m{};
+  if constexpr (N == 2) {
+    const auto d = 2 * (u[0][0] * u[1][1] - u[0][1] * u[1][0]);
+    m[0] = (l[0] * u[1][1] - l[1] * u[0][1]) / d;
+    m[1] = (u[0][0] * l[1] - u[1][0] * l[0]) / d;
+  } else {
+    const auto cross = [](const real<3>& x, const real<3>& y) {
+      return real<3>{x[1] * y[2] - x[2] * y[1], x[2] * y[0] - x[0] * y[2],
+                     x[0] * y[1] - x[1] * y[0]};
+    };
+    const auto vw = cross(u[1], u[2]);
+    const auto wu = cross(u[2], u[0]);
+    const auto uv = cross(u[0], u[1]);
+    const auto d =
+        2 * (u[0][0] * vw[0] + u[0][1] * vw[1] + u[0][2] * vw[2]);
+    for (size_t k = 0; k < 3; ++k)
+      m[k] = (l[0] * vw[k] + l[1] * wu[k] + l[2] * uv[k]) / d;
+  }
+  double r2 = 0;
+  for (size_t k = 0; k < N; ++k) r2 += m[k] * m[k];
+  for (size_t k = 0; k < N; ++k) m[k] += v[0][k];
+  return std::pair{m, r2};
+}
+
+// Vertex of an element given by its index and lattice offset.
+template <size_t N>
+using vertex = std::pair<size_t, offset<N>>;
+
+// Facet opposite to the i-th vertex, sorted and translated such that
+// the offset of its first vertex is zero. Both elements sharing a facet
+// yield the same key.
+template <size_t N>
+auto facet(const element<N>& e, size_t i) {
+  std::array<vertex<N>, N> result{};
+  for (size_t j = 0, l = 0; j <= N; ++j)
+    if (j != i) result[l++] = {e.vertices[j], e.offsets[j]};
+  std::sort(result.begin(), result.end());
+  const auto o = result[0].second;
+  for (auto& [_, x] : result)
+    for (size_t k = 0; k < N; ++k) x[k] -= o[k];
+  return result;
+}
+
+// Element with cached circumsphere in the frame of its first vertex.
+template <size_t N>
+struct cell {
+  element<N> e;
+  real<N> center;
+  double r2;
+};
+
+template <size_t N>
+auto make_cell(const element<N>& e, const std::vector<real<N>>& x,
+               const real<N>& period) {
+  std::array<real<N>, N + 1> v{};
+  for (size_t i = 0; i <= N; ++i)
+    v[i] = image(x[e.vertices[i]], e.offsets[i], period);
+  const auto [center, r2] = circumsphere<N>(v);
+  return cell<N>{e, center, r2};
+}
+
+// Workspace for the insertion of points by the Bowyer-Watson algorithm.
+// The cavity stores every facet together with the removed element
+// containing it, in the frame of the inserted image, and the local index
+// of the opposite vertex.
+template <size_t N>
+struct insertion {
+  struct cavity_facet {
+    element<N> e;
+    size_t i;
+    int count = 0;
+  };
+  std::map<std::array<vertex<N>, N>, cavity_facet> cavity{};
+  std::vector<size_t> bad{};
+  std::vector<cell<N>> created{};
+
+  // Computes the cavity of the given image of a point among the candidate
+  // elements and the elements connecting its boundary to the image.
+  // For periodic triangulations, the image closest to the circumcenter of
+  // an element is tested and the new elements are normalized.
+  // Returns false for duplicated points.
+  bool prepare(const std::vector<cell<N>>& cells,
+               const std::vector<size_t>& candidates,
+               const std::vector<real<N>>& x, const real<N>& period,
+               const vertex<N>& v, bool periodic) {
+    const auto& [pid, o] = v;
+    const auto p = image(x[pid], o, period);
+    cavity.clear();
+    bad.clear();
+    created.clear();
+    bool duplicate = false;
+    for (auto c : candidates) {
+      const auto& [e, center, r2] = cells[c];
+      offset<N> shift{};
+      real<N> q{};
+      double distance = 0, scale = r2;
+      for (size_t k = 0; k < N; ++k) {
+        if (periodic)
+          shift[k] = int(std::round((center[k] - p[k]) / period[k]));
+        q[k] = p[k] + shift[k] * period[k];
+        distance += (q[k] - center[k]) * (q[k] - center[k]);
+        scale += 2 * (q[k] * q[k] + center[k] * center[k]);
+      }
+      const auto tolerance = 1e-12 * scale;
+      if (distance > r2 + tolerance) continue;
+      if (distance >= r2 - tolerance) {
+        std::array<real<N>, N + 1> w{};
+        for (size_t i = 0; i <= N; ++i)
+          w[i] = image(x[e.vertices[i]], e.offsets[i], period);
+        if (!(insphere<N>(w, q) > 0)) continue;
+      }
+
+      bad.push_back(c);
+      auto local = e;
+      for (size_t i = 0; i <= N; ++i) {
+        duplicate |= (e.vertices[i] != pid) && (x[e.vertices[i]] == x[pid]);
+        for (size_t k = 0; k < N; ++k) local.offsets[i][k] -= shift[k];
+      }
+      for (size_t i = 0; i <= N; ++i) {
+        std::array<vertex<N>, N> key{};
+        for (size_t j = 0, l = 0; j <= N; ++j)
+          if (j != i) key[l++] = {local.vertices[j], local.offsets[j]};
+        std::sort(key.begin(), key.end());
+        auto& f = cavity[key];
+        f.e = local;
+        f.i = i;
+        ++f.count;
+      }
+    }
+    if (duplicate || bad.empty()) return false;
+
+    // Every boundary facet is connected to the new point by replacing the
+    // opposite vertex of its removed element, which keeps the orientation.
+    for (const auto& [_, f] : cavity) {
+      if (f.count != 1) continue;
+      auto e = f.e;
+      e.vertices[f.i] = pid;
+      e.offsets[f.i] = o;
+      if (periodic) {
+        const auto first = e.offsets[0];
+        for (auto& y : e.offsets)
+          for (size_t k = 0; k < N; ++k) y[k] -= first[k];
+      }
+      created.push_back(make_cell(e, x, period));
+    }
+    return true;
+  }
+};
+
+// Elements of the periodic triangulation in stable slots. They are sorted
+// into buckets by the position of their circumcenter in the box. Buckets
+// are at least as wide as the largest circumradius. So only the elements
+// in the buckets around a point may contain one of its images. Entries of
+// removed elements are dropped lazily. The buckets are rebuilt when the
+// number of elements has doubled or a circumsphere is too large.
+template <size_t N>
+struct bucket_grid {
+  struct entry {
+    size_t slot;
+    unsigned generation;
+  };
+
+  bucket_grid(std::vector<cell<N>> initial, const domain<N>& box,
+              const real<N>& p)
+      : cells{std::move(initial)},
+        generations(cells.size()),
+        alive(cells.size(), true),
+        min{box.min},
+        period{p} {
+    build();
+  }
+
+  auto position(const real<N>& c) const noexcept {
+    offset<N> result{};
+    for (size_t k = 0; k < N; ++k) {
+      auto t = (c[k] - min[k]) / period[k];
+      t -= std::floor(t);
+      result[k] = std::min(size[k] - 1, int(t * size[k]));
+    }
+    return result;
+  }
+
+  size_t index(const offset<N>& b) const noexcept {
+    size_t result = 0;
+    for (size_t k = N; k-- > 0;) result = result * size[k] + b[k];
+    return result;
+  }
+
+  void add(size_t slot) {
+    buckets[index(position(cells[slot].center))].push_back(
+        {slot, generations[slot]});
+  }
+
+  void build() {
+    radius2 = 0;
+    live = 0;
+    for (size_t i = 0; i < cells.size(); ++i) {
+      if (!alive[i]) continue;
+      radius2 = std::max(radius2, cells[i].r2);
+      ++live;
+    }
+    // The slightly larger width covers the tolerance of the sphere tests.
+    const auto width = 1.001 * std::sqrt(radius2);
+    size_t count = 1;
+    for (size_t k = 0; k < N; ++k) {
+      size[k] = int(std::min(period[k] / width, 1024.0));
+      // With less than three buckets, all of them are neighbors.
+      if (size[k] < 3) size[k] = 1;
+      count *= size[k];
+    }
+    buckets.assign(count, {});
+    for (size_t i = 0; i < cells.size(); ++i)
+      if (alive[i]) add(i);
+    built = live;
+  }
+
+  // Collects the elements whose circumsphere may contain an image of p.
+  void candidates(const real<N>& p, std::vector<size_t>& result) {
+    result.clear();
+    const auto b = position(p);
+    for (size_t c = 0; c < ((N == 2) ? 9 : 27); ++c) {
+      offset<N> d{};
+      bool neighbor = true;
+      for (size_t k = 0, r = c; k < N; ++k, r /= 3) {
+        const int o = int(r % 3) - 1;
+        neighbor &= (size[k] > 1) || (o == 0);
+        d[k] = (b[k] + o + size[k]) % size[k];
+      }
+      if (!neighbor) continue;
+      auto& bucket = buckets[index(d)];
+      std::erase_if(bucket, [this](const entry& e) {
+        return e.generation != generations[e.slot];
+      });
+      for (const auto& e : bucket) result.push_back(e.slot);
+    }
+  }
+
+  void replace(const std::vector<size_t>& bad,
+               const std::vector<cell<N>>& created) {
+    for (auto i : bad) {
+      ++generations[i];
+      alive[i] = false;
+      free.push_back(i);
+    }
+    bool rebuild = false;
+    for (const auto& c : created) {
+      size_t slot = cells.size();
+      if (free.empty()) {
+        cells.push_back(c);
+        generations.push_back(0);
+        alive.push_back(true);
+      } else {
+        slot = free.back();
+        free.pop_back();
+        cells[slot] = c;
+        alive[slot] = true;
+      }
+      rebuild |= (c.r2 > radius2);
+      add(slot);
+    }
+    live = live + created.size() - bad.size();
+    if (rebuild || (live > 2 * built)) build();
+  }
+
+  std::vector<cell<N>> cells{};
+  std::vector<unsigned> generations{};
+  std::vector<char> alive{};
+  std::vector<size_t> free{};
+  real<N> min{};
+  real<N> period{};
+  offset<N> size{};
+  double radius2 = 0;
+  size_t live = 0;
+  size_t built = 0;
+  std::vector<std::vector<entry>> buckets{};
+};
+
+// Triangulates the images of the first m points of the given order in
+// the covering space of 3^N copies of the box and returns the elements of
+// the central copy. Returns nothing if they do not form a valid periodic
+// triangulation. The copies contain cospherical images by construction.
+// So the insertion works with the same double precision predicates as
+// the periodic one and not with the float based ghost engines.
+template <size_t N>
+auto covering_triangulation(const std::vector<real<N>>& x,
+                            const size_t* order, size_t m,
+                            const real<N>& period) {
+  // The vertices of the initial simplex are appended to the points.
+  // It contains all images and lies far away from the central copy.
+  const auto n = x.size();
+  auto y = x;
+  double radius = 0;
+  for (size_t k = 0; k < N; ++k) radius += period[k] * period[k];
+  radius = 4 * std::sqrt(radius);
+  const auto center = x[order[0]];
+  element<N> super{};
+  if constexpr (N == 2) {
+    constexpr double pi = 3.14159265358979323846;
+    for (size_t i = 0; i < 3; ++i) {
+      const auto angle = pi / 2 + i * 2 * pi / 3;
+      y.push_back({center[0] + 2 * radius * std::cos(angle),
+                   center[1] + 2 * radius * std::sin(angle)});
+    }
+  } else {
+    // Vertices of a regular, positively oriented tetrahedron.
+    constexpr int signs[4][3] = {{1, 1, 1}, {1, -1, -1}, {-1, -1, 1},
+                                 {-1, 1, -1}};
+    const auto scale = 3 * radius / std::sqrt(3.0);
+    for (const auto& s : signs)
+      y.push_back({center[0] + s[0] * scale, center[1] + s[1] * scale,
+                   center[2] + s[2] * scale});
+  }
+  for (size_t i = 0; i <= N; ++i) super.vertices[i] = n + i;
+  std::vector<cell<N>> cells{make_cell(super, y, period)};
+
+  // The central copy is inserted first.
+  insertion<N> insert{};
+  std::vector<size_t> all{};
+  for (size_t c = 0; c < ((N == 2) ? 9 : 27); ++c) {
+    offset<N> o{};
+    for (size_t k = 0, r = c; k < N; ++k, r /= 3)
+      o[k] = int((r + 1) % 3) - 1;
+    for (size_t s = 0; s < m; ++s) {
+      all.resize(cells.size());
+      std::iota(all.begin(), all.end(), size_t{0});
+      if (!insert.prepare(cells, all, y, period, {order[s], o}, false))
+        continue;
+      delaunay::detail::replace(cells, insert.bad, insert.created);
+    }
+  }
+
+  // The image whose vertex with the smallest index lies in the central
+  // copy represents the element.
+  std::vector<cell<N>> result{};
+  const auto shortest = *std::min_element(period.begin(), period.end());
+  for (const auto& c : cells) {
+    auto e = c.e;
+    size_t first = 0;
+    for (size_t i = 0; i <= N; ++i)
+      if (e.vertices[i] < e.vertices[first]) first = i;
+    if (e.offsets[first] != offset<N>{}) continue;
+    // Central points must not be connected to the initial simplex.
+    bool valid = true;
+    for (auto v : e.vertices) valid &= (v < n);
+    const auto o = e.offsets[0];
+    for (auto& z : e.offsets)
+      for (size_t k = 0; k < N; ++k) z[k] -= o[k];
+    if (valid) result.push_back(make_cell(e, x, period));
+    if (!valid || !(4 * result.back().r2 < shortest * shortest)) {
+      result.clear();
+      return result;
+    }
+  }
+
+  // The triangulation of the box is closed if every facet is shared
+  // by exactly two elements.
+  std::map<std::array<vertex<N>, N>, int> facets{};
+  for (const auto& c : result)
+    for (size_t i = 0; i <= N; ++i) ++facets[facet(c.e, i)];
+  for (const auto& [_, count] : facets)
+    if (count != 2) result.clear();
+  return result;
+}
+
+}  // namespace detail
+
+// Returns the elements of the periodic Delaunay triangulation.
+// Duplicated points are skipped. Throws if a point lies outside of
+// the domain or if the points are too sparse to triangulate the box.
+// Events of the construction are reported to the statistics policy.
+template <typename Point, size_t N = dimension<Point>(),
+          typename Statistics = no_statistics>
+std::vector<element<N>> triangulation(const std::vector<Point>& points,
+                                      const domain<N>& box,
+                                      Statistics&& statistics = {}) {
+  static_assert((N == 2) || (N == 3));
+  using detail::real;
+  real<N> period{};
+  for (size_t k = 0; k < N; ++k) {
+    period[k] = box.max[k] - box.min[k];
+    if (!(period[k] > 0))
+      throw std::invalid_argument("Periodic domain must not be empty.");
+  }
+  const auto n = points.size();
+  std::vector<real<N>> x(n);
+  for (size_t i = 0; i < n; ++i) {
+    x[i] = coordinates<N>(points[i]);
+    for (size_t k = 0; k < N; ++k)
+      if (!((box.min[k] <= x[i][k]) && (x[i][k] < box.max[k])))
+        throw std::invalid_argument("Point lies outside of periodic domain.");
+  }
+  std::vector<element<N>> result{};
+  if (n == 0) return result;
+
+  // A random sample is spread over the whole box for every input order.
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::shuffle(order.begin(), order.end(), std::mt19937_64{n});
+  size_t m = std::min<size_t>(n, 64);
+  auto cells = detail::covering_triangulation(x, order.data(), m, period);
+  while (cells.empty()) {
+    if (m == n)
+      throw std::runtime_error(
+          "Points are too sparse for a periodic triangulation.");
+    m = std::min(n, 2 * m);
+    cells = detail::covering_triangulation(x, order.data(), m, period);
+  }
+
+  detail::bucket_grid<N> grid{std::move(cells), box, period};
+  detail::insertion<N> insert{};
+  std::vector<size_t> candidates{};
+  for (size_t s = m; s < n; ++s) {
+    const auto pid = order[s];
+    grid.candidates(x[pid], candidates);
+    const auto inserted = insert.prepare(grid.cells, candidates, x, period,
+                                         {pid, offset<N>{}}, true);
+    statistics.test_incircle(candidates.size());
+    if (!inserted) {
+      statistics.skip_duplicate();
+      continue;
+    }
+    statistics.insert();
+    statistics.cavity(insert.bad.size(), insert.created.size());
+    grid.replace(insert.bad, insert.created);
+  }
+
+  result.reserve(grid.live);
+  for (size_t i = 0; i < grid.cells.size(); ++i)
+    if (grid.alive[i]) result.push_back(grid.cells[i].e);
+  return result;
+}
+
+}  // namespace lyrahgames::delaunay::periodic
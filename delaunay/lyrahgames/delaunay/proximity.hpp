@@ -0,0 +1,332 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+//
+#include <lyrahgames/delaunay/parallel.hpp>
+
+namespace lyrahgames::delaunay {
+
+// Graph in compressed sparse row format. The neighbors of vertex v
+// are given by the range [offsets[v], offsets[v + 1]) of targets.
+// Apart from the k-nearest neighbor graph, all graphs are undirected
+// and store every edge in both directions with sorted neighbor lists.
+struct graph {
+  size_t vertex_count() const noexcept { return offsets.size() - 1; }
+  size_t edge_count() const noexcept { return targets.size(); }
+
+  size_t degree(size_t v) const noexcept {
+    return offsets[v + 1] - offsets[v];
+  }
+
+  std::span<const size_t> neighbors(size_t v) const noexcept {
+    return {targets.data() + offsets[v], degree(v)};
+  }
+
+  std::vector<size_t> offsets{0};
+  std::vector<size_t> targets{};
+};
+
+namespace detail {
+
+// Removes all neighbors u of v for which keep(thread, v, u) is false.
+// Rows are processed in parallel by thread_count(n) threads
+// and keep their order.
+template <typename Predicate>
+graph filter(const graph& g, Predicate&& keep) {
+  const auto n = g.vertex_count();
+  const auto threads = thread_count(n);
+  std::vector<char> kept(g.edge_count());
+  graph result{};
+  result.offsets.assign(n + 1, 0);
+  parallel_for(n, threads, [&](size_t thread, size_t first, size_t last) {
+    for (size_t v = first; v < last; ++v) {
+      for (auto i = g.offsets[v]; i < g.offsets[v + 1]; ++i)
+        kept[i] = keep(thread, v, g.targets[i]);
+      result.offsets[v + 1] = std::count(kept.begin() + g.offsets[v],
+                                         kept.begin() + g.offsets[v + 1], 1);
+    }
+  });
+  std::partial_sum(result.offsets.begin(), result.offsets.end(),
+                   result.offsets.begin());
+  result.targets.resize(result.offsets.back());
+  parallel_for(n, threads, [&](size_t, size_t first, size_t last) {
+    for (size_t v = first; v < last; ++v) {
+      auto out = result.offsets[v];
+      for (auto i = g.offsets[v]; i < g.offsets[v + 1]; ++i)
+        if (kept[i]) result.targets[out++] = g.targets[i];
+    }
+  });
+  return result;
+}
+
+// Visits the vertices of a Delaunay graph in the order of their distance
+// to a given source vertex. The k nearest neighbors of a point together
+// with the point itself form a connected subgraph of the Delaunay graph.
+// So a best-first search over the Delaunay edges enumerates them exactly.
+// Visited vertices are marked by the epoch of the current call, such that
+// the marks need not be reset and a lookup takes constant time.
+// The buffers are reused between calls. So every thread should own
+// one instance.
+struct best_first_search {
+  // Calls f(u, squared_distance) for the vertices u != source
+  // in ascending order of distance until f returns false.
+  template <typename Point, typename Functor>
+  void operator()(const std::vector<Point>& points, const graph& delaunay,
+                  size_t source, Functor&& f) {
+    if (marks.size() < delaunay.vertex_count())
+      marks.resize(delaunay.vertex_count(), 0);
+    if (++epoch == 0) {
+      std::fill(marks.begin(), marks.end(), 0);
+      epoch = 1;
+    }
+    const auto& x = points[source];
+    const auto push = [&](size_t u) {
+      if (marks[u] == epoch) return;
+      marks[u] = epoch;
+      const auto d = points[u] - x;
+      queue.push_back({dot(d, d), u});
+      std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+    };
+    marks[source] = epoch;
+    queue.clear();
+    for (auto u : delaunay.neighbors(source)) push(u);
+    while (!queue.empty()) {
+      std::pop_heap(queue.begin(), queue.end(), std::greater<>{});
+      const auto [distance, u] = queue.back();
+      queue.pop_back();
+      if (!f(u, distance)) return;
+      for (auto w : delaunay.neighbors(u)) push(w);
+    }
+  }
+
+  std::vector<std::pair<float, size_t>> queue{};
+  std::vector<uint32_t> marks{};
+  uint32_t epoch{};
+};
+
+}  // namespace detail
+
+// Returns the edges of a simplicial mesh whose elements consist
+// of K vertices, such as the triangles or tetrahedra of a Delaunay
+// triangulation. Neighbor lists are sorted and free of duplicates.
+template <size_t K, typename Elements>
+graph delaunay_graph(const Elements& elements, size_t vertex_count) {
+  // Every element references each of its vertices K - 1 times.
+  // Shared edges are removed afterwards for every vertex in parallel.
+  graph all{};
+  all.offsets.assign(vertex_count + 1, 0);
+  for (const auto& e : elements)
+    for (size_t i = 0; i < K; ++i) all.offsets[e[i] + 1] += K - 1;
+  std::partial_sum(all.offsets.begin(), all.offsets.end(),
+                   all.offsets.begin());
+  all.targets.resize(all.offsets.back());
+  std::vector<size_t> fill(all.offsets.begin(), all.offsets.end() - 1);
+  for (const auto& e : elements)
+    for (size_t i = 0; i < K; ++i)
+      for (size_t j = 0; j < K; ++j)
+        if (i != j) all.targets[fill[e[i]]++] = e[j];
+
+  parallel_for(vertex_count, [&](size_t, size_t first, size_t last) {
+    for (size_t v = first; v < last; ++v) {
+      const auto begin = all.targets.begin() + all.offsets[v];
+      const auto end = all.targets.begin() + all.offsets[v + 1];
+      std::sort(begin, end);
+      // Mark duplicates by the vertex itself, which is no neighbor.
+      std::fill(std::unique(begin, end), end, v);
+    }
+  });
+  return detail::filter(all,
+                        [](size_t, size_t v, size_t u) { return u != v; });
+}
+
+// Gabriel graph whose edges are the Delaunay edges (p, q) whose diametral
+// sphere does not contain any other point. If it contains some point,
+// walking from p towards the midpoint leaves the Voronoi cell of p through
+// a cell whose site lies in the sphere. So only the Delaunay neighbors of
+// one endpoint are tested. Points r in the sphere are characterized by
+// dot(p - r, q - r) < 0.
+template <typename Point>
+graph gabriel_graph(const std::vector<Point>& points, const graph& delaunay) {
+  return detail::filter(delaunay, [&](size_t, size_t v, size_t u) {
+    // Always test from the smaller index such that the result is symmetric.
+    const auto p = std::min(u, v);
+    const auto q = std::max(u, v);
+    for (auto r : delaunay.neighbors(p)) {
+      if (r == q) continue;
+      if (dot(points[p] - points[r], points[q] - points[r]) < 0) return false;
+    }
+    return true;
+  });
+}
+
+// Relative neighborhood graph whose edges are the Delaunay edges (p, q)
+// for which no other point r is closer to both p and q than they are
+// to each other. Its edges are Gabriel edges. In contrast to the
+// Gabriel graph, witnesses do not have to be Delaunay neighbors of p or q.
+// Instead, the points closer to p than q are enumerated by a best-first
+// search, which for Gabriel edges visits only a few points.
+template <typename Point>
+graph relative_neighborhood_graph(const std::vector<Point>& points,
+                                  const graph& delaunay) {
+  const auto gabriel = gabriel_graph(points, delaunay);
+  std::vector<detail::best_first_search> searches(
+      thread_count(gabriel.vertex_count()));
+  return detail::filter(gabriel, [&](size_t thread, size_t v, size_t u) {
+    const auto p = std::min(u, v);
+    const auto q = std::max(u, v);
+    const auto x = points[q] - points[p];
+    const auto length = dot(x, x);
+    auto& search = searches[thread];
+    bool empty = true;
+    search(points, delaunay, p, [&](size_t r, float distance) {
+      if (distance >= length) return false;
+      const auto y = points[q] - points[r];
+      if (dot(y, y) < length) empty = false;
+      return empty;
+    });
+    return empty;
+  });
+}
+
+// Directed graph connecting every point with its k nearest neighbors,
+// sorted by ascending distance. A row has fewer than k entries if fewer
+// vertices can be reached over the Delaunay edges. This is the case for
+// components with at most k vertices and for isolated vertices, such as
+// duplicates skipped by the engine, whose rows are empty.
+template <typename Point>
+graph nearest_neighbor_graph(const std::vector<Point>& points,
+                             const graph& delaunay, size_t k) {
+  const auto n = delaunay.vertex_count();
+  k = std::min(k, std::max<size_t>(n, 1) - 1);
+  // Rows are first written to slots of k entries and compacted afterwards.
+  std::vector<size_t> found(n * k);
+  graph result{};
+  result.offsets.assign(n + 1, 0);
+  if (k > 0) {
+    parallel_for(n, [&](size_t, size_t first, size_t last) {
+      detail::best_first_search search{};
+      for (size_t v = first; v < last; ++v) {
+        auto out = v * k;
+        const auto end = out + k;
+        search(points, delaunay, v, [&](size_t u, float) {
+          found[out++] = u;
+          return out < end;
+        });
+        result.offsets[v + 1] = out - v * k;
+      }
+    });
+  }
+  std::partial_sum(result.offsets.begin(), result.offsets.end(),
+                   result.offsets.begin());
+  result.targets.resize(result.offsets.back());
+  parallel_for(n, [&](size_t, size_t first, size_t last) {
+    for (size_t v = first; v < last; ++v)
+      std::copy_n(found.begin() + v * k, result.degree(v),
+                  result.targets.begin() + result.offsets[v]);
+  });
+  return result;
+}
+
+// Euclidean minimum spanning tree, or forest for disconnected input,
+// computed by Borůvka's algorithm on the Delaunay edges.
+// Every round, all components select their shortest outgoing edge in
+// parallel and are merged along it. Ties are broken by the edge index
+// such that no cycles can occur. So at most log n rounds are needed.
+// The index is packed into 32 bits and limits the number of edges.
+template <typename Point>
+graph minimum_spanning_tree(const std::vector<Point>& points,
+                            const graph& delaunay) {
+  struct edge {
+    size_t u, v;
+    float length;
+  };
+  const auto n = delaunay.vertex_count();
+  std::vector<edge> edges{};
+  edges.reserve(delaunay.edge_count() / 2);
+  for (size_t v = 0; v < n; ++v)
+    for (auto u : delaunay.neighbors(v)) {
+      if (u < v) continue;
+      const auto x = points[u] - points[v];
+      edges.push_back({v, u, dot(x, x)});
+    }
+
+  // The selection key of an edge packs the bits of its non-negative length,
+  // which are ordered like the length itself, with the edge index.
+  constexpr auto none = std::numeric_limits<uint64_t>::max();
+  std::vector<std::atomic<uint64_t>> best(n);
+  std::vector<size_t> component(n);
+  std::iota(component.begin(), component.end(), size_t{0});
+  const auto find = [&component](size_t v) {
+    while (component[v] != v) v = component[v] = component[component[v]];
+    return v;
+  };
+  std::vector<std::pair<size_t, size_t>> tree{};
+  tree.reserve(n);
+
+  while (!edges.empty()) {
+    for (auto& b : best) b.store(none, std::memory_order_relaxed);
+    parallel_for(edges.size(), [&](size_t, size_t first, size_t last) {
+      const auto select = [](std::atomic<uint64_t>& b, uint64_t key) {
+        auto current = b.load(std::memory_order_relaxed);
+        while ((key < current) &&
+               !b.compare_exchange_weak(current, key,
+                                        std::memory_order_relaxed)) {
+        }
+      };
+      for (auto i = first; i < last; ++i) {
+        const auto& e = edges[i];
+        const uint64_t key =
+            (uint64_t(std::bit_cast<uint32_t>(e.length)) << 32) | i;
+        select(best[component[e.u]], key);
+        select(best[component[e.v]], key);
+      }
+    });
+
+    for (size_t c = 0; c < n; ++c) {
+      const auto key = best[c].load(std::memory_order_relaxed);
+      if (key == none) continue;
+      const auto& e = edges[key & 0xffffffffu];
+      // Both components may have selected the same edge.
+      const auto a = find(e.u);
+      const auto b = find(e.v);
+      if (a == b) continue;
+      component[std::max(a, b)] = std::min(a, b);
+      tree.push_back({e.u, e.v});
+    }
+    for (size_t v = 0; v < n; ++v) component[v] = find(v);
+    std::erase_if(edges, [&component](const edge& e) {
+      return component[e.u] == component[e.v];
+    });
+  }
+
+  graph result{};
+  result.offsets.assign(n + 1, 0);
+  for (const auto& [u, v] : tree) {
+    ++result.offsets[u + 1];
+    ++result.offsets[v + 1];
+  }
+  std::partial_sum(result.offsets.begin(), result.offsets.end(),
+                   result.offsets.begin());
+  result.targets.resize(result.offsets.back());
+  std::vector<size_t> fill(result.offsets.begin(), result.offsets.end() - 1);
+  for (const auto& [u, v] : tree) {
+    result.targets[fill[u]++] = v;
+    result.targets[fill[v]++] = u;
+  }
+  for (size_t v = 0; v < n; ++v)
+    std::sort(result.targets.begin() + result.offsets[v],
+              result.targets.begin() + result.offsets[v + 1]);
+  return result;
+}
+
+}  // namespace lyrahgames::delaunay
@@ -1,59 +1,92 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 
 namespace lyrahgames::delaunay {
 
-struct quad_edge_algebra {
-  struct alignas(2 * sizeof(size_t)) edge {
-    size_t next{};
-    size_t data{};
+// Quad-edge algebra whose edges are referenced by indices instead of
+// tagged pointers. The lowest two bits of an index select the rotation of
+// the edge inside its quad-edge. So the structure can be relocated, copied,
+// serialized, and grown by 'resize'. With 32-bit indices, a quad-edge takes
+// 32 bytes instead of 64 bytes.
+template <typename Index>
+struct basic_quad_edge_algebra {
+  static_assert(std::is_unsigned_v<Index>);
+  using index = Index;
+
+  struct alignas(2 * sizeof(Index)) edge {
+    Index next{};
+    Index data{};
   };
 
-  static_assert(sizeof(edge) == 2 * sizeof(size_t));
+  static_assert(sizeof(edge) == 2 * sizeof(Index));
   static_assert(alignof(edge) == sizeof(edge));
 
-  static constexpr size_t type_mask = 0b11;
-  static constexpr size_t base_mask = ~type_mask;
-  static_assert(sizeof(size_t) == sizeof(ptrdiff_t));
+  static constexpr Index type_mask = 0b11;
+  static constexpr Index base_mask = ~type_mask;
 
-  constexpr size_t rotation(size_t eid, ptrdiff_t n = 1) noexcept {
-    const auto rid = static_cast<size_t>(eid + n);
+  constexpr Index rotation(Index eid, ptrdiff_t n = 1) const noexcept {
+    const auto rid = static_cast<Index>(eid + static_cast<Index>(n));
     return (eid & base_mask) | (rid & type_mask);
   }
-  constexpr size_t symmetric(size_t eid) noexcept { return rotation(eid, 2); }
-  constexpr size_t next(size_t eid) noexcept { return edges[eid].next; }
-  constexpr size_t previous(size_t eid) noexcept {
+  constexpr Index symmetric(Index eid) const noexcept {
+    return rotation(eid, 2);
+  }
+  constexpr Index next(Index eid) const noexcept { return edges[eid].next; }
+  constexpr Index previous(Index eid) const noexcept {
     return rotation(next(rotation(eid)));
   }
-  constexpr size_t& origin(size_t eid) noexcept { return edges[eid].data; }
-  constexpr size_t& destination(size_t eid) noexcept {
+  constexpr Index& origin(Index eid) noexcept { return edges[eid].data; }
+  constexpr Index origin(Index eid) const noexcept { return edges[eid].data; }
+  constexpr Index& destination(Index eid) noexcept {
+    return origin(symmetric(eid));
+  }
+  constexpr Index destination(Index eid) const noexcept {
     return origin(symmetric(eid));
   }
-  constexpr size_t& left(size_t eid) noexcept {
+  constexpr Index& left(Index eid) noexcept {
     return origin(rotation(eid, -1));
   }
-  constexpr size_t& right(size_t eid) noexcept {
+  constexpr Index left(Index eid) const noexcept {
+    return origin(rotation(eid, -1));
+  }
+  constexpr Index& right(Index eid) noexcept {
+    return origin(rotation(eid, 1));
+  }
+  constexpr Index right(Index eid) const noexcept {
     return origin(rotation(eid, 1));
   }
 
-  constexpr size_t rotl(size_t eid) noexcept { return rotation(eid, 1); }
-  constexpr size_t rotr(size_t eid) noexcept { return rotation(eid, -1); }
-  constexpr size_t sym(size_t eid) noexcept { return symmetric(eid); }
-  constexpr size_t onext(size_t eid) noexcept { return next(eid); }
-  constexpr size_t oprev(size_t eid) noexcept { return rotl(onext(rotl(eid))); }
-  constexpr size_t dnext(size_t eid) noexcept { return sym(onext(sym(eid))); }
-  constexpr size_t dprev(size_t eid) noexcept { return rotr(onext(rotr(eid))); }
-  constexpr size_t lnext(size_t eid) noexcept { return rotl(onext(rotr(eid))); }
-  constexpr size_t lprev(size_t eid) noexcept { return sym(onext(eid)); }
-  constexpr size_t rnext(size_t eid) noexcept { return rotr(onext(rotl(eid))); }
-  constexpr size_t rprev(size_t eid) noexcept { return onext(sym(eid)); }
-  constexpr size_t& odata(size_t eid) noexcept { return origin(eid); }
-  constexpr size_t& ddata(size_t eid) noexcept { return destination(eid); }
-  constexpr size_t& ldata(size_t eid) noexcept { return left(eid); }
-  constexpr size_t& rdata(size_t eid) noexcept { return right(eid); }
-
-  size_t new_edge() {
-    const auto eid = edges.size();
+  constexpr Index rotl(Index eid) const noexcept { return rotation(eid, 1); }
+  constexpr Index rotr(Index eid) const noexcept { return rotation(eid, -1); }
+  constexpr Index sym(Index eid) const noexcept { return symmetric(eid); }
+  constexpr Index onext(Index eid) const noexcept { return next(eid); }
+  constexpr Index oprev(Index eid) const noexcept {
+    return rotl(onext(rotl(eid)));
+  }
+  constexpr Index dnext(Index eid) const noexcept {
+    return sym(onext(sym(eid)));
+  }
+  constexpr Index dprev(Index eid) const noexcept {
+    return rotr(onext(rotr(eid)));
+  }
+  constexpr Index lnext(Index eid) const noexcept {
+    return rotl(onext(rotr(eid)));
+  }
+  constexpr Index lprev(Index eid) const noexcept { return sym(onext(eid)); }
+  constexpr Index rnext(Index eid) const noexcept {
+    return rotr(onext(rotl(eid)));
+  }
+  constexpr Index rprev(Index eid) const noexcept { return onext(sym(eid)); }
+  constexpr Index& odata(Index eid) noexcept { return origin(eid); }
+  constexpr Index& ddata(Index eid) noexcept { return destination(eid); }
+  constexpr Index& ldata(Index eid) noexcept { return left(eid); }
+  constexpr Index& rdata(Index eid) noexcept { return right(eid); }
+
+  Index new_edge() {
+    const auto eid = static_cast<Index>(edges.size());
     edges.resize(eid + 4);
     edges[eid + 0].next = eid + 0;
     edges[eid + 1].next = eid + 3;
@@ -62,7 +95,7 @@ struct quad_edge_algebra {
     return eid;
   }
 
-  void splice(size_t a, size_t b) noexcept {
+  void splice(Index a, Index b) noexcept {
     const auto alpha = rotl(onext(a));
     const auto beta = rotl(onext(b));
     const auto t1 = onext(b);
@@ -75,7 +108,7 @@ struct quad_edge_algebra {
     edges[beta].next = t4;
   }
 
-  size_t connection(size_t a, size_t b) noexcept {
+  Index connection(Index a, Index b) {
     auto e = new_edge();
     odata(e) = ddata(a);
     ddata(e) = odata(b);
@@ -84,12 +117,12 @@ struct quad_edge_algebra {
     return e;
   }
 
-  void remove(size_t e) noexcept {
+  void remove(Index e) noexcept {
     splice(e, oprev(e));
     splice(sym(e), oprev(sym(e)));
   }
 
-  void swap(size_t e) noexcept {
+  void swap(Index e) noexcept {
     auto a = previous(e);
     auto b = previous(symmetric(e));
     splice(e, a);
@@ -103,4 +136,9 @@ struct quad_edge_algebra {
   std::vector<edge> edges;
 };
 
-}  // namespace lyrahgames::delaunay
\ No newline at end of file
+using quad_edge_algebra = basic_quad_edge_algebra<size_t>;
+using quad_edge_algebra32 = basic_quad_edge_algebra<uint32_t>;
+
+static_assert(sizeof(quad_edge_algebra32::edge) * 4 == 32);
+
+}  // namespace lyrahgames::delaunay
@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+//
+#include <lyrahgames/delaunay/bowyer_watson.hpp>
+#include <lyrahgames/delaunay/hilbert.hpp>
+#include <lyrahgames/delaunay/parallel.hpp>
+#include <lyrahgames/delaunay/vector.hpp>
+
+namespace lyrahgames::delaunay {
+
+// The predicates for integer points are exact if all coordinates lie
+// in a range of width 2^30. Then every coordinate difference is bounded
+// by 2^30, the orientation by 2^61, and the incircle determinant
+// by 3 * 2^122. The orientation fits into 64-bit integers
+// and the incircle determinant into 128-bit integers.
+constexpr size_t exact_coordinate_bits = 30;
+
+constexpr auto orientation(const int32x2& a, const int32x2& b,
+                           const int32x2& c) noexcept {
+  const int64_t u[2] = {int64_t{b[0]} - a[0], int64_t{b[1]} - a[1]};
+  const int64_t v[2] = {int64_t{c[0]} - a[0], int64_t{c[1]} - a[1]};
+  return u[0] * v[1] - u[1] * v[0];
+}
+
+constexpr auto counterclockwise(const int32x2& a, const int32x2& b,
+                                const int32x2& c) noexcept {
+  return orientation(a, b, c) > 0;
+}
+
+constexpr auto clockwise(const int32x2& a, const int32x2& b,
+                         const int32x2& c) noexcept {
+  return orientation(a, b, c) < 0;
+}
+
+// Assuming that a, b, and p are collinear, tests
+// if p lies in the interior of the segment from a to b.
+constexpr auto strictly_between(const int32x2& a, const int32x2& b,
+                                const int32x2& p) noexcept {
+  const auto dot = [](const int32x2& x, const int32x2& y, const int32x2& z) {
+    return (int64_t{x[0]} - y[0]) * (int64_t{z[0]} - y[0]) +
+           (int64_t{x[1]} - y[1]) * (int64_t{z[1]} - y[1]);
+  };
+  return (dot(p, a, b) > 0) && (dot(p, b, a) > 0);
+}
+
+// Tests if p lies strictly inside the circumcircle of the triangle a, b, c
+// of any orientation. Degenerate triangles contain no points.
+constexpr auto circumcircle_intersection(const int32x2& a,  //
+                                         const int32x2& b,  //
+                                         const int32x2& c,  //
+                                         const int32x2& p) noexcept {
+  using int128_t = __int128;
+  const int64_t u[2] = {int64_t{b[0]} - a[0], int64_t{b[1]} - a[1]};
+  const int64_t v[2] = {int64_t{c[0]} - a[0], int64_t{c[1]} - a[1]};
+  const int64_t r[2] = {int64_t{p[0]} - a[0], int64_t{p[1]} - a[1]};
+
+  const auto u2 = u[0] * u[0] + u[1] * u[1];
+  const auto v2 = v[0] * v[0] + v[1] * v[1];
+  const auto r2 = r[0] * r[0] + r[1] * r[1];
+
+  const auto orientation = u[0] * v[1] - u[1] * v[0];
+
+  const auto determinant =
+      int128_t{r[0]} * (int128_t{u[1]} * v2 - int128_t{v[1]} * u2) -
+      int128_t{r[1]} * (int128_t{u[0]} * v2 - int128_t{v[0]} * u2) +
+      int128_t{r2} * orientation;
+
+  return ((orientation > 0) && (determinant < 0)) ||
+         ((orientation < 0) && (determinant > 0));
+}
+
+// Points snapped to a uniform integer grid over their bounding box.
+// The original position of a grid point is origin + q / scale.
+struct quantized_point_set {
+  auto position(const int32x2& q) const noexcept {
+    return float64x2{origin[0] + q[0] / scale, origin[1] + q[1] / scale};
+  }
+
+  std::vector<int32x2> points{};
+  float64x2 origin{};
+  // Number of grid cells per unit length.
+  double scale{};
+};
+
+// Snaps the points to a grid with 2^bits cells per axis
+// that covers the bounding box of the points.
+// The aspect ratio is preserved and so Delaunay triangulations
+// of the grid points are Delaunay for the quantized input.
+template <typename Point>
+auto quantize(const std::vector<Point>& points,
+              size_t bits = exact_coordinate_bits) {
+  if ((bits == 0) || (bits > exact_coordinate_bits))
+    throw std::invalid_argument(
+        "Quantization bits have to be in the range of exact predicates.");
+  quantized_point_set result{};
+  result.points.resize(points.size());
+  if (points.empty()) return result;
+
+  const auto [low, high] = bounding_box<2>(points);
+  const auto extent = std::max(high[0] - low[0], high[1] - low[1]);
+  const auto max = static_cast<double>((int64_t{1} << bits) - 1);
+  result.origin = {low[0], low[1]};
+  result.scale = (extent > 0) ? (max / extent) : 1;
+
+  parallel_for(points.size(), [&](size_t, size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      const auto x = coordinates<2>(points[i]);
+      for (size_t k = 0; k < 2; ++k)
+        result.points[i][k] = static_cast<int32_t>(std::clamp(
+            std::round((x[k] - low[k]) * result.scale), 0.0, max));
+    }
+  });
+  return result;
+}
+
+}  // namespace lyrahgames::delaunay
+
+namespace lyrahgames::delaunay::bowyer_watson::quantized {
+
+// Triangulates the points after quantizing them to the integer grid
+// of exact predicates. No floating-point predicate is evaluated and so
+// the result is exactly Delaunay with respect to the grid points.
+// Points snapped to the same grid point are duplicates and only
+// the first one of them is referenced by the triangles.
+// Integer input whose coordinates already lie in a range of width 2^30
+// can be triangulated without quantization by 'ghost::triangulation'.
+template <template <typename> typename Allocator = std::allocator,
+          typename Point, typename Statistics = no_statistics>
+auto triangulation(const std::vector<Point>& points,
+                   connectivity<3>* adjacency = nullptr,
+                   Statistics&& statistics = {}) {
+  return ghost::triangulation<Allocator>(quantize(points).points, adjacency,
+                                         std::forward<Statistics>(statistics));
+}
+
+}  // namespace lyrahgames::delaunay::bowyer_watson::quantized
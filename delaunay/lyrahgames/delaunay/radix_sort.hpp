@@ -0,0 +1,62 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+//
+#include <lyrahgames/delaunay/parallel.hpp>
+
+namespace lyrahgames::delaunay {
+
+// Stable least-significant-digit radix sort of key-value pairs
+// by 8-bit digits. Every pass computes a histogram of digits for each thread
+// chunk and scatters the chunks in parallel. Because the chunks are scattered
+// to disjoint ranges in their original order, the sort is stable.
+// Passes whose digit is the same for all keys are skipped.
+inline void radix_sort(std::vector<uint64_t>& keys,
+                       std::vector<size_t>& values) {
+  constexpr size_t radix = 256;
+  const auto n = keys.size();
+  const auto threads = thread_count(n);
+
+  std::vector<uint64_t> key_buffer(n);
+  std::vector<size_t> value_buffer(n);
+  std::vector<std::array<size_t, radix>> offsets(threads);
+
+  for (size_t shift = 0; shift < 64; shift += 8) {
+    parallel_for(n, threads, [&](size_t t, size_t first, size_t last) {
+      auto& histogram = offsets[t];
+      histogram.fill(0);
+      for (size_t i = first; i < last; ++i)
+        ++histogram[(keys[i] >> shift) & (radix - 1)];
+    });
+
+    // Turn the histograms into scatter offsets ordered by digit and thread.
+    bool trivial = false;
+    size_t sum = 0;
+    for (size_t d = 0; d < radix; ++d) {
+      size_t count = 0;
+      for (size_t t = 0; t < threads; ++t) {
+        const auto c = offsets[t][d];
+        offsets[t][d] = sum;
+        sum += c;
+        count += c;
+      }
+      trivial |= (count == n);
+    }
+    if (trivial) continue;
+
+    parallel_for(n, threads, [&](size_t t, size_t first, size_t last) {
+      auto& offset = offsets[t];
+      for (size_t i = first; i < last; ++i) {
+        const auto j = offset[(keys[i] >> shift) & (radix - 1)]++;
+        key_buffer[j] = keys[i];
+        value_buffer[j] = values[i];
+      }
+    });
+    keys.swap(key_buffer);
+    values.swap(value_buffer);
+  }
+}
+
+}  // namespace lyrahgames::delaunay
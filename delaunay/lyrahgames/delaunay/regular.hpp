@@ -0,0 +1,397 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+//
+#include <lyrahgames/delaunay/bowyer_watson.hpp>
+#include <lyrahgames/delaunay/cavity.hpp>
+#include <lyrahgames/delaunay/connectivity.hpp>
+#include <lyrahgames/delaunay/delaunay.hpp>
+#include <lyrahgames/delaunay/geometry.hpp>
+#include <lyrahgames/delaunay/statistics.hpp>
+
+namespace lyrahgames::delaunay::regular {
+
+// Weighted Delaunay triangulations, also called regular triangulations,
+// are the duals of power diagrams. A point x with weight w is lifted to
+// (x, |x|^2 - w) and the triangulation is the projection of the lower
+// convex hull of all lifted points. For equal weights, it is the Delaunay
+// triangulation. A point whose lifted point does not lie below the lower
+// hull is redundant. It is no vertex of the triangulation and its power cell
+// is empty. In particular, this is the case for a duplicated point whose
+// weight is not larger than the weight of the other one.
+//
+// The engines are the ghost variants of the Bowyer-Watson algorithm with
+// the incircle test replaced by the power test. A point that is in conflict
+// with no element is redundant and skipped. A vertex whose elements are all
+// removed by an insertion becomes redundant and vanishes from the result.
+// All power tests are evaluated in double precision.
+
+using point = float32x2;
+using point3 = experimental_3d::point;
+using triangle = std::array<size_t, 3>;
+using tetrahedron = std::array<size_t, 4>;
+
+namespace detail {
+
+// Lifts x relative to p. The lifted point of p is the origin.
+inline auto lift(const point& x, float wx, const point& p, float wp) noexcept {
+  const double dx = double(x[0]) - p[0], dy = double(x[1]) - p[1];
+  return std::array<double, 3>{dx, dy, dx * dx + dy * dy - wx + wp};
+}
+
+inline auto lift(const point3& x, float wx, const point3& p,
+                 float wp) noexcept {
+  const double dx = double(x.x) - p.x, dy = double(x.y) - p.y,
+               dz = double(x.z) - p.z;
+  return std::array<double, 4>{dx, dy, dz,
+                               dx * dx + dy * dy + dz * dz - wx + wp};
+}
+
+}  // namespace detail
+
+// Positive if the lifted point of p lies below the plane through
+// the lifted points of the counterclockwise triangle (a, b, c).
+inline double power_test(const point& a, float wa, const point& b, float wb,
+                         const point& c, float wc, const point& p,
+                         float wp) noexcept {
+  const auto [ax, ay, al] = detail::lift(a, wa, p, wp);
+  const auto [bx, by, bl] = detail::lift(b, wb, p, wp);
+  const auto [cx, cy, cl] = detail::lift(c, wc, p, wp);
+  return al * (bx * cy - cx * by) - bl * (ax * cy - cx * ay) +
+         cl * (ax * by - bx * ay);
+}
+
+// Positive if the lifted point of p lies below the hyperplane through
+// the lifted points of the positively oriented tetrahedron (a, b, c, d).
+inline double power_test(const point3& a, float wa, const point3& b, float wb,
+                         const point3& c, float wc, const point3& d, float wd,
+                         const point3& p, float wp) noexcept {
+  const auto [ax, ay, az, al] = detail::lift(a, wa, p, wp);
+  const auto [bx, by, bz, bl] = detail::lift(b, wb, p, wp);
+  const auto [cx, cy, cz, cl] = detail::lift(c, wc, p, wp);
+  const auto [dx, dy, dz, dl] = detail::lift(d, wd, p, wp);
+  const auto ab = ax * by - bx * ay;
+  const auto bc = bx * cy - cx * by;
+  const auto cd = cx * dy - dx * cy;
+  const auto da = dx * ay - ax * dy;
+  const auto ac = ax * cy - cx * ay;
+  const auto bd = bx * dy - dx * by;
+  const auto abc = az * bc - bz * ac + cz * ab;
+  const auto bcd = bz * cd - cz * bd + dz * bc;
+  const auto cda = cz * da + dz * ac + az * cd;
+  const auto dab = dz * ab + az * bd + bz * da;
+  return (al * bcd - bl * cda) + (cl * dab - dl * abc);
+}
+
+namespace detail {
+
+// For p on the line through a and b, a point in conflict with the ghost
+// triangle of the hull edge (a, b) lies below the lifted line.
+// Its barycentric coordinates are given by the projection onto the edge.
+inline bool ghost_conflict(const point& a, float wa, const point& b, float wb,
+                           const point& p, float wp) noexcept {
+  if (counterclockwise(a, b, p)) return true;
+  if (clockwise(a, b, p)) return false;
+  const auto [ax, ay, al] = lift(a, wa, p, wp);
+  const auto [bx, by, bl] = lift(b, wb, p, wp);
+  const double ux = bx - ax, uy = by - ay;
+  const double length = ux * ux + uy * uy;
+  const double t = -(ax * ux + ay * uy);
+  return (length - t) * al + t * bl > 0;
+}
+
+// For p in the plane of the hull face (a, b, c), the barycentric
+// coordinates are the ratios of the areas of the triangles with p.
+inline bool ghost_conflict(const point3& a, float wa, const point3& b,
+                           float wb, const point3& c, float wc,
+                           const point3& p, float wp) noexcept {
+  const auto o = experimental_3d::ghost::orientation(a, b, c, p);
+  if (o > 0) return true;
+  if (o < 0) return false;
+  const auto [ax, ay, az, al] = lift(a, wa, p, wp);
+  const auto [bx, by, bz, bl] = lift(b, wb, p, wp);
+  const auto [cx, cy, cz, cl] = lift(c, wc, p, wp);
+  const auto cross = [](double x0, double x1, double x2, double y0, double y1,
+                        double y2) {
+    return std::array<double, 3>{x1 * y2 - x2 * y1, x2 * y0 - x0 * y2,
+                                 x0 * y1 - x1 * y0};
+  };
+  const auto n = cross(bx - ax, by - ay, bz - az, cx - ax, cy - ay, cz - az);
+  const auto x = cross(bx, by, bz, cx, cy, cz);
+  const auto y = cross(cx, cy, cz, ax, ay, az);
+  const auto z = cross(ax, ay, az, bx, by, bz);
+  double result = 0;
+  for (int i = 0; i < 3; ++i)
+    result += (al * x[i] + bl * y[i] + cl * z[i]) * n[i];
+  return result > 0;
+}
+
+inline void check_weights(size_t points, size_t weights) {
+  if (points != weights)
+    throw std::invalid_argument("Every point needs exactly one weight.");
+}
+
+}  // namespace detail
+
+// Returns the counterclockwise triangles of the regular triangulation.
+// If the connectivity is requested, the neighbors of all triangles and
+// the triangles around each vertex will be filled during the final pass.
+// Redundant points have no triangles around them. Skipped redundant points
+// are reported as duplicates to the statistics policy.
+template <template <typename> typename Allocator = std::allocator,
+          typename Statistics = no_statistics>
+std::vector<triangle, Allocator<triangle>> triangulation(
+    const std::vector<point>& points, const std::vector<float>& weights,
+    connectivity<3>* adjacency = nullptr, Statistics&& statistics = {}) {
+  using bowyer_watson::edge;
+  using bowyer_watson::ghost::infinity;
+  using hull_edge = std::array<size_t, 2>;
+  detail::check_weights(points.size(), weights.size());
+  std::vector<triangle, Allocator<triangle>> triangles{};
+  if (adjacency) adjacency->reset(points.size());
+
+  // Find the first three points that are not collinear.
+  const auto n = points.size();
+  const auto equal = [](const point& x, const point& y) {
+    return (x[0] == y[0]) && (x[1] == y[1]);
+  };
+  size_t seed[3] = {0, 1, 0};
+  while ((seed[1] < n) && equal(points[0], points[seed[1]])) ++seed[1];
+  if (seed[1] >= n) return triangles;
+  seed[2] = seed[1] + 1;
+  while ((seed[2] < n) &&
+         !counterclockwise(points[0], points[seed[1]], points[seed[2]]) &&
+         !clockwise(points[0], points[seed[1]], points[seed[2]]))
+    ++seed[2];
+  if (seed[2] >= n) return triangles;
+  if (clockwise(points[0], points[seed[1]], points[seed[2]]))
+    std::swap(seed[1], seed[2]);
+
+  triangles.push_back({seed[0], seed[1], seed[2]});
+  std::vector<hull_edge, Allocator<hull_edge>> ghosts{
+      {seed[1], seed[0]}, {seed[2], seed[1]}, {seed[0], seed[2]}};
+
+  // The polygon stores every edge of the cavity together with
+  // its direction in the removed element that inserted it last.
+  struct directed_edge {
+    size_t from, to;
+    int count = 0;
+  };
+  std::map<edge, directed_edge, std::less<edge>,
+           Allocator<std::pair<const edge, directed_edge>>>
+      polygon{};
+  const auto add_edge = [&polygon](size_t a, size_t b) {
+    auto& e = polygon[{a, b}];
+    e.from = a;
+    e.to = b;
+    ++e.count;
+  };
+  std::vector<size_t, Allocator<size_t>> bad_triangles{};
+  std::vector<size_t, Allocator<size_t>> bad_ghosts{};
+  std::vector<triangle, Allocator<triangle>> new_triangles{};
+  std::vector<hull_edge, Allocator<hull_edge>> new_ghosts{};
+
+  for (size_t pid = 1; pid < n; ++pid) {
+    if ((pid == seed[1]) || (pid == seed[2])) continue;
+    const auto& p = points[pid];
+    const auto w = weights[pid];
+
+    polygon.clear();
+    bad_triangles.clear();
+    bad_ghosts.clear();
+
+    for (size_t i = 0; i < triangles.size(); ++i) {
+      const auto [a, b, c] = triangles[i];
+      if (!(power_test(points[a], weights[a], points[b], weights[b],
+                       points[c], weights[c], p, w) > 0))
+        continue;
+      bad_triangles.push_back(i);
+      add_edge(a, b);
+      add_edge(b, c);
+      add_edge(c, a);
+    }
+    for (size_t i = 0; i < ghosts.size(); ++i) {
+      const auto [a, b] = ghosts[i];
+      if (!detail::ghost_conflict(points[a], weights[a], points[b],
+                                  weights[b], p, w))
+        continue;
+      bad_ghosts.push_back(i);
+      add_edge(a, b);
+      add_edge(b, infinity);
+      add_edge(infinity, a);
+    }
+    statistics.test_incircle(triangles.size());
+    statistics.test_orientation(ghosts.size());
+    if (bad_triangles.empty() && bad_ghosts.empty()) {
+      statistics.skip_duplicate();
+      continue;
+    }
+    statistics.insert();
+
+    // Connect every directed boundary edge of the cavity to the new point.
+    new_triangles.clear();
+    new_ghosts.clear();
+    for (const auto& [_, e] : polygon) {
+      if (e.count != 1) continue;
+      if (e.from == infinity)
+        new_ghosts.push_back({e.to, pid});
+      else if (e.to == infinity)
+        new_ghosts.push_back({pid, e.from});
+      else
+        new_triangles.push_back({e.from, e.to, pid});
+    }
+    statistics.cavity(bad_triangles.size() + bad_ghosts.size(),
+                      new_triangles.size() + new_ghosts.size());
+    delaunay::detail::replace(triangles, bad_triangles, new_triangles);
+    delaunay::detail::replace(ghosts, bad_ghosts, new_ghosts);
+  }
+
+  if (adjacency) {
+    for (const auto& t : triangles) adjacency->count(t);
+    adjacency->assemble(triangles);
+  }
+  return triangles;
+}
+
+// Returns the positively oriented tetrahedra of the regular triangulation.
+// Real tetrahedra (a, b, c, d) are positively oriented which means
+// that d lies on the positive side of the face (a, b, c).
+// Connectivity and statistics are handled like in the two-dimensional case.
+template <template <typename> typename Allocator = std::allocator,
+          typename Statistics = no_statistics>
+std::vector<tetrahedron, Allocator<tetrahedron>> triangulation(
+    const std::vector<point3>& points, const std::vector<float>& weights,
+    connectivity<4>* adjacency = nullptr, Statistics&& statistics = {}) {
+  using experimental_3d::face;
+  using experimental_3d::ghost::infinity;
+  using experimental_3d::ghost::orientation;
+  using hull_face = std::array<size_t, 3>;
+  detail::check_weights(points.size(), weights.size());
+  std::vector<tetrahedron, Allocator<tetrahedron>> tetrahedra{};
+  if (adjacency) adjacency->reset(points.size());
+
+  // Find the first four points that are not coplanar.
+  const auto n = points.size();
+  const auto equal = [](const point3& x, const point3& y) {
+    return (x.x == y.x) && (x.y == y.y) && (x.z == y.z);
+  };
+  size_t seed[4] = {0, 1, 0, 0};
+  while ((seed[1] < n) && equal(points[0], points[seed[1]])) ++seed[1];
+  if (seed[1] >= n) return tetrahedra;
+  seed[2] = seed[1] + 1;
+  while ((seed[2] < n) && (sqnorm(cross(points[seed[1]] - points[0],
+                                        points[seed[2]] - points[0])) == 0))
+    ++seed[2];
+  if (seed[2] >= n) return tetrahedra;
+  seed[3] = seed[2] + 1;
+  while ((seed[3] < n) && (orientation(points[0], points[seed[1]],
+                                       points[seed[2]], points[seed[3]]) == 0))
+    ++seed[3];
+  if (seed[3] >= n) return tetrahedra;
+  if (orientation(points[0], points[seed[1]], points[seed[2]],
+                  points[seed[3]]) < 0)
+    std::swap(seed[1], seed[2]);
+
+  tetrahedra.push_back({seed[0], seed[1], seed[2], seed[3]});
+  // The faces of a positively oriented tetrahedron (a, b, c, d) whose
+  // positive side is the interior are (a, b, c), (b, d, c), (a, c, d),
+  // and (a, d, b). Ghosts are given by their reversed orientation.
+  const auto [a, b, c, d] = tetrahedra[0];
+  std::vector<hull_face, Allocator<hull_face>> ghosts{
+      {a, c, b}, {b, c, d}, {a, d, c}, {a, b, d}};
+
+  // The polytope stores every face of the cavity together with
+  // its orientation in the removed element that inserted it last.
+  struct oriented_face {
+    std::array<size_t, 3> v;
+    int count = 0;
+  };
+  std::unordered_map<face, oriented_face, face::hash, std::equal_to<face>,
+                     Allocator<std::pair<const face, oriented_face>>>
+      polytope{};
+  const auto add_face = [&polytope](size_t a, size_t b, size_t c) {
+    auto& f = polytope[{a, b, c}];
+    f.v = {a, b, c};
+    ++f.count;
+  };
+  std::vector<size_t, Allocator<size_t>> bad_tetrahedra{};
+  std::vector<size_t, Allocator<size_t>> bad_ghosts{};
+  std::vector<tetrahedron, Allocator<tetrahedron>> new_tetrahedra{};
+  std::vector<hull_face, Allocator<hull_face>> new_ghosts{};
+
+  for (size_t pid = 1; pid < n; ++pid) {
+    if ((pid == seed[1]) || (pid == seed[2]) || (pid == seed[3])) continue;
+    const auto& p = points[pid];
+    const auto w = weights[pid];
+
+    polytope.clear();
+    bad_tetrahedra.clear();
+    bad_ghosts.clear();
+
+    for (size_t i = 0; i < tetrahedra.size(); ++i) {
+      const auto [a, b, c, d] = tetrahedra[i];
+      if (!(power_test(points[a], weights[a], points[b], weights[b],
+                       points[c], weights[c], points[d], weights[d], p,
+                       w) > 0))
+        continue;
+      bad_tetrahedra.push_back(i);
+      add_face(a, b, c);
+      add_face(b, d, c);
+      add_face(a, c, d);
+      add_face(a, d, b);
+    }
+    for (size_t i = 0; i < ghosts.size(); ++i) {
+      const auto [a, b, c] = ghosts[i];
+      if (!detail::ghost_conflict(points[a], weights[a], points[b],
+                                  weights[b], points[c], weights[c], p, w))
+        continue;
+      bad_ghosts.push_back(i);
+      add_face(a, b, c);
+      add_face(b, infinity, c);
+      add_face(a, c, infinity);
+      add_face(a, infinity, b);
+    }
+    statistics.test_incircle(tetrahedra.size());
+    statistics.test_orientation(ghosts.size());
+    if (bad_tetrahedra.empty() && bad_ghosts.empty()) {
+      statistics.skip_duplicate();
+      continue;
+    }
+    statistics.insert();
+
+    // Connect every oriented boundary face of the cavity to the new point.
+    // A face (u, infinity, w) becomes the ghost (p, u, w).
+    new_tetrahedra.clear();
+    new_ghosts.clear();
+    for (const auto& [_, f] : polytope) {
+      if (f.count != 1) continue;
+      const auto [a, b, c] = f.v;
+      if (a == infinity)
+        new_ghosts.push_back({pid, c, b});
+      else if (b == infinity)
+        new_ghosts.push_back({pid, a, c});
+      else if (c == infinity)
+        new_ghosts.push_back({pid, b, a});
+      else
+        new_tetrahedra.push_back({a, b, c, pid});
+    }
+    statistics.cavity(bad_tetrahedra.size() + bad_ghosts.size(),
+                      new_tetrahedra.size() + new_ghosts.size());
+    delaunay::detail::replace(tetrahedra, bad_tetrahedra, new_tetrahedra);
+    delaunay::detail::replace(ghosts, bad_ghosts, new_ghosts);
+  }
+
+  if (adjacency) {
+    for (const auto& t : tetrahedra) adjacency->count(t);
+    adjacency->assemble(tetrahedra);
+  }
+  return tetrahedra;
+}
+
+}  // namespace lyrahgames::delaunay::regular
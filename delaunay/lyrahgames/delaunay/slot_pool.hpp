@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace lyrahgames::delaunay {
+
+// Dense pool of elements with stable slots in a contiguous array.
+// Erased slots become tombstones and are pushed to a free list from which
+// later insertions reuse them. So iteration visits contiguous memory and,
+// after the pool has grown to its peak size, neither insertion nor erasure
+// allocates. Every slot has a generation counter which is odd while the slot
+// is alive and is incremented by every insertion and erasure. Handles store
+// the generation of their element such that stale handles are detected.
+template <typename T, template <typename> typename Allocator = std::allocator>
+struct slot_pool {
+  struct handle {
+    size_t slot;
+    uint32_t generation;
+  };
+
+  size_t size() const noexcept { return count; }
+  bool empty() const noexcept { return count == 0; }
+  // Number of slots including tombstones. Iterate over them
+  // and skip the ones which are not alive.
+  size_t slot_count() const noexcept { return values.size(); }
+  bool alive(size_t slot) const noexcept { return generations[slot] & 1; }
+  bool contains(handle h) const noexcept {
+    return (h.slot < values.size()) && (generations[h.slot] == h.generation);
+  }
+
+  T& operator[](size_t slot) noexcept { return values[slot]; }
+  const T& operator[](size_t slot) const noexcept { return values[slot]; }
+  T& operator[](handle h) noexcept { return values[h.slot]; }
+  const T& operator[](handle h) const noexcept { return values[h.slot]; }
+
+  handle insert(const T& value) {
+    size_t slot;
+    if (free.empty()) {
+      slot = values.size();
+      values.push_back(value);
+      generations.push_back(0);
+    } else {
+      slot = free.back();
+      free.pop_back();
+      values[slot] = value;
+    }
+    ++count;
+    return {slot, ++generations[slot]};
+  }
+
+  // The slot has to be alive.
+  void erase(size_t slot) {
+    ++generations[slot];
+    free.push_back(slot);
+    --count;
+  }
+  // Erasing through a stale handle does nothing. Otherwise, the element
+  // now stored in its slot would be erased and the slot freed twice.
+  void erase(handle h) {
+    if (contains(h)) erase(h.slot);
+  }
+
+  void reserve(size_t n) {
+    values.reserve(n);
+    generations.reserve(n);
+    free.reserve(n);
+  }
+
+  std::vector<T, Allocator<T>> values{};
+  std::vector<uint32_t, Allocator<uint32_t>> generations{};
+  std::vector<size_t, Allocator<size_t>> free{};
+  size_t count{};
+};
+
+}  // namespace lyrahgames::delaunay
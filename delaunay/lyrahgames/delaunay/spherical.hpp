@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+//
+#include <lyrahgames/delaunay/connectivity.hpp>
+#include <lyrahgames/delaunay/convex_hull.hpp>
+#include <lyrahgames/delaunay/hilbert.hpp>
+#include <lyrahgames/delaunay/statistics.hpp>
+
+namespace lyrahgames::delaunay::spherical {
+
+// Delaunay triangulation of points on the sphere. The circumcircle of three
+// points on the sphere is the intersection with the plane through them.
+// So a triangle is Delaunay if and only if no other point lies beyond its
+// plane and the triangulation is the convex hull of the points. In contrast
+// to a stereographic projection, the hull engine sees the points directly
+// and no region of the sphere is magnified.
+
+using point = std::array<double, 3>;
+using triangle = convex_hull::face;
+
+// Unit vector of the given longitude and latitude in radians.
+inline point direction(double longitude, double latitude) noexcept {
+  const auto c = std::cos(latitude);
+  return {c * std::cos(longitude), c * std::sin(longitude),
+          std::sin(latitude)};
+}
+
+// Returns the Delaunay triangles of the points on the sphere around the
+// origin. Points are projected radially to the unit sphere before.
+// Triangles are counterclockwise when seen from the outside. Points with
+// the same direction are skipped. Throws if a point lies at the origin.
+// If the connectivity is requested, the neighbors of all triangles
+// and the triangles around each vertex are computed.
+// Events of the construction are reported to the statistics policy.
+template <typename Point, typename Statistics = no_statistics>
+std::vector<triangle> triangulation(const std::vector<Point>& points,
+                                    connectivity<3>* adjacency = nullptr,
+                                    Statistics&& statistics = {}) {
+  static_assert(dimension<Point>() == 3);
+  std::vector<point> x(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    x[i] = coordinates<3>(points[i]);
+    const auto [u, v, w] = x[i];
+    const auto r = std::sqrt(u * u + v * v + w * w);
+    if (!(r > 0))
+      throw std::invalid_argument("Point on sphere has no direction.");
+    for (auto& y : x[i]) y /= r;
+  }
+  return convex_hull::triangulation(x, adjacency, statistics);
+}
+
+}  // namespace lyrahgames::delaunay::spherical
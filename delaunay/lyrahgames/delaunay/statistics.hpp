@@ -0,0 +1,69 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+
+namespace lyrahgames::delaunay {
+
+// Statistics policy that ignores every event.
+// It is the default for all engines such that the hot paths
+// do not pay for the instrumentation.
+struct no_statistics {
+  constexpr void insert() const noexcept {}
+  constexpr void skip_duplicate() const noexcept {}
+  constexpr void test_orientation(size_t = 1) const noexcept {}
+  constexpr void test_incircle(size_t = 1) const noexcept {}
+  constexpr void walk(size_t) const noexcept {}
+  constexpr void cavity(size_t, size_t) const noexcept {}
+  constexpr void flip() const noexcept {}
+};
+
+// Histogram with a bin for every power of two.
+// Bin 0 counts zeros and bin k > 0 counts values in [2^(k-1), 2^k).
+struct log2_histogram {
+  void add(size_t value) noexcept {
+    ++bins[std::bit_width(value)];
+    ++count;
+    sum += value;
+    max = std::max(max, value);
+  }
+
+  double mean() const noexcept {
+    return count ? static_cast<double>(sum) / count : 0.0;
+  }
+
+  std::array<size_t, 8 * sizeof(size_t) + 1> bins{};
+  size_t count{};
+  size_t sum{};
+  size_t max{};
+};
+
+// Statistics policy collecting counters and histograms
+// for every phase of the incremental construction.
+struct statistics {
+  void insert() noexcept { ++insertions; }
+  void skip_duplicate() noexcept { ++duplicates; }
+  void test_orientation(size_t n = 1) noexcept { orientation_tests += n; }
+  void test_incircle(size_t n = 1) noexcept { incircle_tests += n; }
+  void walk(size_t steps) noexcept { walk_lengths.add(steps); }
+  void cavity(size_t removed, size_t created) noexcept {
+    removed_elements.add(removed);
+    created_elements.add(created);
+  }
+  void flip() noexcept { ++flips; }
+
+  // Insertion
+  size_t insertions{};
+  size_t duplicates{};
+  // Point location and conflict search
+  size_t orientation_tests{};
+  size_t incircle_tests{};
+  log2_histogram walk_lengths{};
+  // Retriangulation
+  log2_histogram removed_elements{};
+  log2_histogram created_elements{};
+  size_t flips{};
+};
+
+}  // namespace lyrahgames::delaunay
@@ -0,0 +1,254 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+//
+#include <lyrahgames/delaunay/connectivity.hpp>
+#include <lyrahgames/delaunay/guibas_stolfi.hpp>
+#include <lyrahgames/delaunay/parallel.hpp>
+
+namespace lyrahgames::delaunay::tiled {
+
+// Domain decomposition for large point sets. The points are partitioned
+// by a kd-tree into tiles of at most 'tile_size' points, which are
+// triangulated independently and in parallel by the quad-edge engine.
+// A triangle of a tile is final if its circumcircle lies strictly inside
+// the region of its tile, because no other tile can have a point inside.
+// The remaining border points, which are the vertices of all other
+// triangles, are triangulated once more. Every Delaunay triangle that is not
+// final has only border points as vertices. So it is contained in this
+// second triangulation and the triangles covering the final ones
+// are removed by a flood fill starting at the edges shared with them.
+
+using point = guibas_stolfi::point;
+using triangle = std::array<size_t, 3>;
+
+namespace detail {
+
+// Tile given by the range [first, last) of the partition together
+// with its region. Outer regions are unbounded.
+struct tile {
+  size_t first, last;
+  float32x2 min, max;
+};
+
+// Splits all tiles with more than 'tile_size' points at the median of
+// their longest side until all of them are small enough.
+// The tiles of every level are split in parallel.
+inline auto partition(const std::vector<point>& points,
+                      std::vector<size_t>& order, size_t tile_size) {
+  constexpr auto infinity = std::numeric_limits<float>::infinity();
+  std::vector<tile> tiles{{0, points.size(), {-infinity, -infinity},
+                           {infinity, infinity}}};
+  std::vector<tile> next{};
+  while (std::any_of(tiles.begin(), tiles.end(), [tile_size](const tile& t) {
+    return t.last - t.first > tile_size;
+  })) {
+    next.resize(2 * tiles.size());
+    const auto threads = std::min(tiles.size(), thread_count(order.size()));
+    parallel_for(tiles.size(), threads, [&](size_t, size_t first, size_t last) {
+      for (auto i = first; i < last; ++i) {
+        auto t = tiles[i];
+        if (t.last - t.first <= tile_size) {
+          next[2 * i] = t;
+          next[2 * i + 1] = {t.last, t.last, t.min, t.max};
+          continue;
+        }
+        auto low = points[order[t.first]];
+        auto high = low;
+        for (auto j = t.first; j < t.last; ++j) {
+          low = delaunay::min(low, points[order[j]]);
+          high = delaunay::max(high, points[order[j]]);
+        }
+        const size_t axis = (high[1] - low[1] > high[0] - low[0]) ? 1 : 0;
+        const auto middle = order.begin() + (t.first + t.last) / 2;
+        std::nth_element(order.begin() + t.first, middle,
+                         order.begin() + t.last, [&](size_t a, size_t b) {
+                           return points[a][axis] < points[b][axis];
+                         });
+        const auto split = points[*middle][axis];
+        const auto m = static_cast<size_t>(middle - order.begin());
+        next[2 * i] = {t.first, m, t.min, t.max};
+        next[2 * i].max[axis] = split;
+        next[2 * i + 1] = {m, t.last, t.min, t.max};
+        next[2 * i + 1].min[axis] = split;
+      }
+    });
+    std::erase_if(next, [](const tile& t) { return t.first == t.last; });
+    std::swap(tiles, next);
+  }
+  return tiles;
+}
+
+// Triangulates the points with the given indices inside the super triangle.
+// Triangles are returned with global indices. If 'border' is given,
+// the positions of points connected to the super triangle are set.
+inline auto triangulate(const std::vector<point>& points,
+                        const std::array<point, 3>& super,
+                        const size_t* indices, size_t n,
+                        std::vector<char>* border = nullptr) {
+  std::vector<point> local(n + 3);
+  std::copy(super.begin(), super.end(), local.begin());
+  for (size_t i = 0; i < n; ++i) local[i + 3] = points[indices[i]];
+  guibas_stolfi::edge_algebra diagram{};
+  // Every insertion creates three edges and flips reuse them.
+  diagram.edges.reserve(3 * n + 3);
+  diagram.set_super_triangle(&local[0], &local[1], &local[2]);
+  for (size_t i = 0; i < n; ++i) diagram.add(&local[i + 3]);
+
+  if (border) {
+    const auto first = local.data() + 3;
+    for (auto& q : diagram.edges) {
+      const auto o = static_cast<point*>(q[0].data) - first;
+      const auto d = static_cast<point*>(q[2].data) - first;
+      if ((o < 0) && (d >= 0)) (*border)[d] = true;
+      if ((d < 0) && (o >= 0)) (*border)[o] = true;
+    }
+  }
+  auto result = diagram.triangles(local.data() + 3, n);
+  for (auto& t : result)
+    for (auto& v : t) v = indices[v];
+  return result;
+}
+
+// Checks whether the circumcircle of the counterclockwise triangle (a, b, c)
+// lies strictly inside the given box. The margin accounts for the
+// rounding errors of the circumcenter.
+inline bool circumcircle_inside(const point& a, const point& b,
+                                const point& c, const point& min,
+                                const point& max) noexcept {
+  const double ux = double(b[0]) - a[0], uy = double(b[1]) - a[1];
+  const double vx = double(c[0]) - a[0], vy = double(c[1]) - a[1];
+  const double d = 2 * (ux * vy - uy * vx);
+  if (!(d > 0)) return false;
+  const double u2 = ux * ux + uy * uy;
+  const double v2 = vx * vx + vy * vy;
+  const double x = (vy * u2 - uy * v2) / d;
+  const double y = (ux * v2 - vx * u2) / d;
+  const double cx = a[0] + x, cy = a[1] + y;
+  const double r = std::sqrt(x * x + y * y) +
+                   1e-6 * (std::sqrt(u2 + v2) + std::abs(cx) + std::abs(cy));
+  return (min[0] < cx - r) && (cx + r < max[0]) &&  //
+         (min[1] < cy - r) && (cy + r < max[1]);
+}
+
+}  // namespace detail
+
+// Returns the counterclockwise Delaunay triangles of all points.
+// Like for the other engines with a super triangle, very thin triangles
+// at the convex hull may be missing and duplicated points are skipped.
+// With a single tile, this is the plain quad-edge triangulation.
+// The merge of the tiles is done sequentially and its cost grows with the
+// number of border points. So tiles should not be chosen too small.
+inline std::vector<triangle> triangulation(
+    const std::vector<point>& points, connectivity<3>* adjacency = nullptr,
+    size_t tile_size = size_t{1} << 12) {
+  const auto n = points.size();
+  tile_size = std::max<size_t>(tile_size, 1);
+  std::vector<triangle> result{};
+  if (adjacency) adjacency->reset(n);
+  if (n < 3) return result;
+  const auto super = bounding_triangle(bounding_circle(bounding_box(points)));
+
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), size_t{0});
+  const auto tiles = detail::partition(points, order, tile_size);
+
+  // Triangulate every tile and keep its final triangles.
+  std::vector<std::vector<triangle>> finals(tiles.size());
+  std::vector<char> border(n, false);
+  // Every thread gets at least one tile.
+  const auto threads = thread_count(n, tile_size);
+  parallel_for(tiles.size(), threads, [&](size_t, size_t first, size_t last) {
+    std::vector<char> boundary{};
+    for (auto i = first; i < last; ++i) {
+      const auto& tile = tiles[i];
+      const auto m = tile.last - tile.first;
+      const auto indices = order.data() + tile.first;
+      if (tiles.size() == 1) {
+        finals[i] = detail::triangulate(points, super, indices, m);
+        continue;
+      }
+      boundary.assign(m, false);
+      const auto triangles =
+          detail::triangulate(points, super, indices, m, &boundary);
+      for (const auto& t : triangles) {
+        if (detail::circumcircle_inside(points[t[0]], points[t[1]],
+                                        points[t[2]], tile.min, tile.max)) {
+          finals[i].push_back(t);
+          continue;
+        }
+        for (auto v : t) border[v] = true;
+      }
+      // Tiles own disjoint ranges of points.
+      for (size_t j = 0; j < m; ++j)
+        if (boundary[j]) border[indices[j]] = true;
+    }
+  });
+  for (auto& f : finals) result.insert(result.end(), f.begin(), f.end());
+
+  if (tiles.size() > 1) {
+    // Final edges whose endpoints are both border points are the only ones
+    // that may occur in the triangulation of the border points.
+    std::vector<size_t> border_points{};
+    for (size_t v = 0; v < n; ++v)
+      if (border[v]) border_points.push_back(v);
+    std::vector<std::pair<size_t, size_t>> edges{};
+    for (const auto& t : result)
+      for (size_t k = 0; k < 3; ++k) {
+        const auto a = t[k], b = t[(k + 1) % 3];
+        if (border[a] && border[b]) edges.push_back({a, b});
+      }
+    std::sort(edges.begin(), edges.end());
+    const auto final_edge = [&edges](size_t a, size_t b) {
+      return std::binary_search(edges.begin(), edges.end(), std::pair{a, b});
+    };
+
+    const auto triangles = detail::triangulate(
+        points, super, border_points.data(), border_points.size());
+    const auto neighbors = make_connectivity<3>(triangles, n).neighbors;
+
+    // A triangle on the left side of a directed final edge covers final
+    // triangles and so do all triangles reachable without crossing
+    // the boundary of the region of final triangles.
+    std::vector<char> covered(triangles.size(), false);
+    std::vector<size_t> stack{};
+    for (size_t i = 0; i < triangles.size(); ++i) {
+      const auto& t = triangles[i];
+      for (size_t k = 0; k < 3; ++k) {
+        if (!final_edge(t[k], t[(k + 1) % 3])) continue;
+        covered[i] = true;
+        stack.push_back(i);
+        break;
+      }
+    }
+    while (!stack.empty()) {
+      const auto i = stack.back();
+      stack.pop_back();
+      const auto& t = triangles[i];
+      for (size_t k = 0; k < 3; ++k) {
+        const auto a = t[(k + 1) % 3], b = t[(k + 2) % 3];
+        const auto j = neighbors[i][k];
+        if ((j == connectivity<3>::none) || covered[j]) continue;
+        if (final_edge(a, b) && !final_edge(b, a)) continue;
+        covered[j] = true;
+        stack.push_back(j);
+      }
+    }
+    for (size_t i = 0; i < triangles.size(); ++i)
+      if (!covered[i]) result.push_back(triangles[i]);
+  }
+
+  if (adjacency) {
+    for (const auto& t : result) adjacency->count(t);
+    adjacency->assemble(result);
+  }
+  return result;
+}
+
+}  // namespace lyrahgames::delaunay::tiled
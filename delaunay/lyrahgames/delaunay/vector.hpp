@@ -1,6 +1,7 @@
 #pragma once
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 //
 #include <lyrahgames/delaunay/type_traits.hpp>
 
@@ -185,5 +186,6 @@ using float32x2 = vector<float, 2>;
 using float64x2 = vector<double, 2>;
 using float32x3 = vector<float, 3>;
 using float64x3 = vector<double, 3>;
+using int32x2 = vector<int32_t, 2>;
 
 }  // namespace lyrahgames::delaunay
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <array>
 #include <chrono>
+#include <deque>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <random>
@@ -7,6 +9,7 @@
 //
 #include <SFML/Graphics.hpp>
 //
+#include <lyrahgames/delaunay/async.hpp>
 #include <lyrahgames/delaunay/bowyer_watson.hpp>
 // #include <lyrahgames/delaunay/delaunay.hpp>
 
@@ -15,8 +18,8 @@ int main() {
   using namespace lyrahgames;
   // using delaunay::point;
   // using delaunay::simplex;
-  using delaunay::bowyer_watson::point;
-  using delaunay::bowyer_watson::triangle;
+  using delaunay::async::point;
+  using delaunay::async::triangle;
 
   cout << "Press space to regenerate points and triangulation.\n\n" << flush;
 
@@ -30,21 +33,30 @@ int main() {
   // vector<simplex> elements{};
   vector<triangle> elements{};
 
+  // The triangulation runs in slices on the render thread. Every frame
+  // processes the pending slices with a fixed time budget.
+  deque<function<void()>> tasks{};
+  const auto executor = [&tasks](function<void()> task) {
+    tasks.push_back(std::move(task));
+  };
+  delaunay::async::job job{};
+  auto start = chrono::high_resolution_clock::now();
+
   const auto generate_points_and_triangulate = [&](size_t n) {
     // Generate random points.
     points.resize(n);
     for (auto& p : points) p = point{random(), random()};
 
-    // Construct Delaunay triangulation and measure time taken.
-    const auto start = chrono::high_resolution_clock::now();
+    // Stop a running triangulation and start the construction of the new
+    // Delaunay triangulation while measuring the time taken.
+    if (job.valid()) job.cancel();
+    elements.clear();
+    start = chrono::high_resolution_clock::now();
     // elements = delaunay::triangulation(points);
     // elements = delaunay::bowyer_watson::triangulation(points);
-    elements = delaunay::bowyer_watson::experimental::triangulation(points);
-    const auto end = chrono::high_resolution_clock::now();
-    const auto time = chrono::duration<float>(end - start).count();
-    cout << "Delaunay triangulation took " << time << " s for " << n
-         << " points.\n"
-         << flush;
+    // elements = delaunay::bowyer_watson::experimental::triangulation(points);
+    job = delaunay::async::triangulation(points, executor,
+                                         chrono::milliseconds{8});
   };
 
   constexpr size_t samples = 10000;
@@ -133,6 +145,24 @@ int main() {
       }
     }
 
+    // Continue the triangulation and show the result when it is done.
+    for (auto pending = tasks.size(); pending > 0; --pending) {
+      auto task = std::move(tasks.front());
+      tasks.pop_front();
+      task();
+    }
+    if (job.valid() && job.ready()) {
+      const auto size = job.size();
+      elements = job.get();
+      job = {};
+      const auto end = chrono::high_resolution_clock::now();
+      const auto time = chrono::duration<float>(end - start).count();
+      cout << "Delaunay triangulation took " << time << " s for " << size
+           << " points.\n"
+           << flush;
+      update = 2;
+    }
+
     if (update) {
       // Update view.
       fov_x = fov_y * width / height;
@@ -1,3 +1,4 @@
+#include <array>
 #include <iomanip>
 #include <iostream>
 #include <random>
@@ -50,7 +51,9 @@ void generate_random_points_and_triangulate() {
     v = point{2 * dist(rng) - 1, 2 * dist(rng) - 1, 2 * dist(rng) - 1};
   }
 
-  const auto tetrahedrons = delaunay::experimental_3d::triangulation(vertices);
+  vector<array<size_t, 3>> hull{};
+  const auto tetrahedrons =
+      delaunay::experimental_3d::triangulation(vertices, nullptr, &hull);
 
   elements.resize(12 * tetrahedrons.size());
   size_t i = 0;
@@ -74,24 +77,9 @@ void generate_random_points_and_triangulate() {
     i += 12;
   }
 
-  unordered_map<delaunay::experimental_3d::face, int,
-                delaunay::experimental_3d::face::hash>
-      tmp;
-  for (const auto& t : tetrahedrons) {
-    ++tmp[{t[0], t[1], t[2]}];
-    ++tmp[{t[1], t[2], t[3]}];
-    ++tmp[{t[2], t[3], t[0]}];
-    ++tmp[{t[3], t[0], t[1]}];
-  }
-
   surface_elements.clear();
-  for (const auto& [f, i] : tmp) {
-    if (i == 1) {
-      surface_elements.push_back(f[0]);
-      surface_elements.push_back(f[1]);
-      surface_elements.push_back(f[2]);
-    }
-  }
+  for (const auto& f : hull)
+    surface_elements.insert(end(surface_elements), begin(f), end(f));
 }
 
 bool draw_surface_elements = false;
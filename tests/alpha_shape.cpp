@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/alpha_shape.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+
+TEST_CASE("The alpha complex of a 3D mesh is a filtered simplicial complex.") {
+  using namespace delaunay::experimental_3d;
+
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+  const auto random = [&] { return dist(rng); };
+
+  vector<point> points(500);
+  for (auto& p : points) p = point{random(), random(), random()};
+  const auto mesh = compact::triangulation(points);
+  const auto complex = make_alpha_complex(mesh);
+
+  // The complete complex is a triangulated ball.
+  CHECK(complex.vertices.size() - complex.edges.size() +
+            complex.faces.size() - complex.tetrahedra.size() ==
+        1);
+  const auto filtration = complex.filtration();
+  CHECK(filtration.size() == complex.vertices.size() + complex.edges.size() +
+                                 complex.faces.size() +
+                                 complex.tetrahedra.size());
+  CHECK(is_sorted(filtration.begin(), filtration.end(),
+                  [](const auto& x, const auto& y) {
+                    return x.alpha < y.alpha;
+                  }));
+
+  map<array<uint32_t, 3>, float> face_alpha{};
+  for (const auto& f : complex.faces) {
+    auto v = f.vertices;
+    sort(v.begin(), v.end());
+    face_alpha[v] = f.alpha;
+    CHECK(f.alpha <= f.mid);
+    CHECK(f.mid <= f.max);
+  }
+  map<array<uint32_t, 2>, float> edge_alpha{};
+  for (const auto& e : complex.edges) edge_alpha[e.vertices] = e.alpha;
+
+  // Every face of a simplex in the complex is part of the complex, too.
+  for (const auto alpha : {1e-4f, 1e-3f, 4e-3f, 1e-2f, 1.0f}) {
+    for (const auto& t : complex.tetrahedra_until(alpha)) {
+      const auto& v = mesh.tetrahedra()[t.index].vertices;
+      for (const auto& fv : compact::face_vertices) {
+        array<uint32_t, 3> f{v[fv[0]], v[fv[1]], v[fv[2]]};
+        sort(f.begin(), f.end());
+        CHECK(face_alpha[f] <= alpha);
+      }
+    }
+    for (const auto& f : complex.faces_until(alpha)) {
+      auto v = f.vertices;
+      sort(v.begin(), v.end());
+      CHECK(edge_alpha[{v[0], v[1]}] <= alpha);
+      CHECK(edge_alpha[{v[0], v[2]}] <= alpha);
+      CHECK(edge_alpha[{v[1], v[2]}] <= alpha);
+    }
+  }
+
+  // For the largest alpha, the boundary is the convex hull oriented outwards.
+  const auto hull = complex.boundary(numeric_limits<float>::max());
+  REQUIRE(!hull.empty());
+  for (const auto& f : hull) {
+    const auto [a, b, c] = f.vertices;
+    for (const auto& p : points)
+      CHECK(ghost::orientation(points[a], points[b], points[c], p) <= 1e-6f);
+  }
+}
+
+TEST_CASE("The 2D alpha shape of an annulus is bounded by two polygons.") {
+  using namespace delaunay::bowyer_watson;
+
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{-1, 1};
+
+  vector<point> points{};
+  while (points.size() < 2000) {
+    const point p{dist(rng), dist(rng)};
+    const auto r2 = sqnorm(p);
+    if ((0.25f < r2) && (r2 < 1)) points.push_back(p);
+  }
+  const auto complex = experimental::alpha_triangulation(points);
+  CHECK(complex.vertices.size() - complex.edges.size() +
+            complex.triangles.size() ==
+        1);
+
+  map<array<size_t, 2>, float> edge_alpha{};
+  for (const auto& e : complex.edges) {
+    edge_alpha[{min(e.vertices[0], e.vertices[1]),
+                max(e.vertices[0], e.vertices[1])}] = e.alpha;
+    CHECK(e.alpha <= e.mid);
+  }
+
+  const auto area = [&points](const auto& polygon) {
+    float result = 0;
+    for (size_t i = 0; i < polygon.size(); ++i) {
+      const auto& p = points[polygon[i]];
+      const auto& q = points[polygon[(i + 1) % polygon.size()]];
+      result += p[0] * q[1] - p[1] * q[0];
+    }
+    return result / 2;
+  };
+
+  // The alpha value is a squared radius. So the alpha shape
+  // closes the gaps between the points but keeps the hole.
+  const auto alpha = 0.04f;
+  for (const auto& t : complex.triangles_until(alpha)) {
+    const auto [a, b, c] = t.vertices;
+    CHECK(edge_alpha[{min(a, b), max(a, b)}] <= alpha);
+    CHECK(edge_alpha[{min(b, c), max(b, c)}] <= alpha);
+    CHECK(edge_alpha[{min(a, c), max(a, c)}] <= alpha);
+  }
+  const auto polygons = complex.polygons(alpha);
+  REQUIRE(polygons.size() == 2);
+  const auto outer = max(area(polygons[0]), area(polygons[1]));
+  const auto inner = min(area(polygons[0]), area(polygons[1]));
+  CHECK(outer == doctest::Approx(3.14159f).epsilon(0.05));
+  CHECK(inner == doctest::Approx(-0.785398f).epsilon(0.1));
+
+  // For the largest alpha, the shape is the convex hull.
+  const auto hull = complex.polygons(numeric_limits<float>::max());
+  REQUIRE(hull.size() == 1);
+  CHECK(area(hull[0]) > 0);
+}
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/async.hpp>
+#include <lyrahgames/delaunay/tiled.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::async::point;
+using delaunay::async::triangle;
+
+TEST_CASE("Asynchronous triangulation runs in slices on an executor.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{-1, 1};
+
+  vector<point> points(5000);
+  for (auto& p : points) p = point{dist(rng), dist(rng)};
+  // A single tile is the plain quad-edge triangulation.
+  const auto expected =
+      delaunay::tiled::triangulation(points, nullptr, points.size());
+
+  // Tasks are run one after another on the current thread like in a
+  // render loop that processes a single task per frame.
+  deque<function<void()>> tasks{};
+  const auto queue = [&tasks](function<void()> f) {
+    tasks.push_back(std::move(f));
+  };
+
+  SUBCASE("Thread Executor") {
+    const auto job = delaunay::async::triangulation(
+        points, [](function<void()> f) { thread{std::move(f)}.detach(); });
+    CHECK(job.get() == expected);
+    CHECK(job.progress() == points.size());
+  }
+
+  SUBCASE("Time Budget") {
+    const auto job = delaunay::async::triangulation(points, queue,
+                                                    chrono::microseconds{50});
+    REQUIRE(job.size() == points.size());
+    size_t slices = 0;
+    size_t progress = 0;
+    while (!job.ready()) {
+      REQUIRE(tasks.size() == 1);
+      auto task = std::move(tasks.front());
+      tasks.pop_front();
+      task();
+      ++slices;
+      CHECK(job.progress() > progress);
+      progress = job.progress();
+    }
+    CHECK(tasks.empty());
+    CHECK(slices > 1);
+    CHECK(job.get() == expected);
+  }
+
+  SUBCASE("Cancellation") {
+    const auto job = delaunay::async::triangulation(points, queue,
+                                                    chrono::microseconds{1});
+    tasks.front()();
+    tasks.pop_front();
+    CHECK(!job.ready());
+    CHECK(job.progress() < points.size());
+    job.cancel();
+    tasks.front()();
+    tasks.pop_front();
+    CHECK(tasks.empty());
+    CHECK(job.ready());
+    CHECK(job.cancelled());
+    CHECK_THROWS_AS(job.get(), runtime_error);
+  }
+
+  SUBCASE("Empty Executor") {
+    CHECK_THROWS_AS(delaunay::async::triangulation(points, {}),
+                    invalid_argument);
+  }
+}
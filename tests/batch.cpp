@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/batch.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::batch::point;
+using delaunay::batch::triangle;
+
+namespace {
+
+// Rotate every triangle to start at its smallest index.
+template <typename Iterator>
+auto normalized(Iterator first, Iterator last) {
+  vector<triangle> result(first, last);
+  for (auto& t : result)
+    rotate(t.begin(), min_element(t.begin(), t.end()), t.end());
+  sort(result.begin(), result.end());
+  return result;
+}
+
+}  // namespace
+
+TEST_CASE("Many small point sets are triangulated in one batch.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{-1, 1};
+  uniform_int_distribution<size_t> sizes{0, 64};
+
+  vector<point> points{};
+  vector<size_t> offsets{0};
+  for (size_t s = 0; s < 3000; ++s) {
+    const auto n = sizes(rng);
+    for (size_t i = 0; i < n; ++i)
+      points.push_back(point{dist(rng), dist(rng)});
+    // Duplicated points are skipped.
+    if (n > 8) points.back() = points[offsets.back() + n / 2];
+    offsets.push_back(points.size());
+  }
+
+  const auto result = delaunay::batch::triangulation(points, offsets);
+  REQUIRE(result.offsets.size() == offsets.size());
+  CHECK(result.offsets.back() == result.triangles.size());
+  for (size_t s = 0; s + 1 < offsets.size(); ++s) {
+    const auto expected = delaunay::fixed::triangulation<64>(
+        points.data() + offsets[s], offsets[s + 1] - offsets[s]);
+    CHECK(normalized(result.triangles.begin() + result.offsets[s],
+                     result.triangles.begin() + result.offsets[s + 1]) ==
+          normalized(expected.begin(), expected.end()));
+  }
+
+  CHECK_THROWS_AS(delaunay::batch::triangulation<16>(points, offsets),
+                  length_error);
+  offsets.back() = 0;
+  CHECK_THROWS_AS(delaunay::batch::triangulation(points, offsets),
+                  invalid_argument);
+}
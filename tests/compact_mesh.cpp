@@ -0,0 +1,90 @@
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/compact_mesh.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+
+TEST_CASE("The compact mesh stores a linked Delaunay tetrahedralization.") {
+  using namespace delaunay::experimental_3d;
+  using namespace delaunay::experimental_3d::compact;
+
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+  const auto random = [&] { return dist(rng); };
+
+  vector<point> points(300);
+  for (auto& p : points) p = point{random(), random(), random()};
+  // Duplicates are skipped.
+  for (size_t i = 0; i < 10; ++i) points.push_back(points[i]);
+
+  const auto check = [&points](const auto& tetrahedra) {
+    REQUIRE(!tetrahedra.empty());
+    size_t boundary_faces = 0;
+    vector<bool> boundary(points.size(), false);
+    vector<bool> used(points.size(), false);
+    for (uint32_t t = 0; t < tetrahedra.size(); ++t) {
+      const auto& [v, n] = tetrahedra[t];
+      CHECK(orientation(points[v[0]], points[v[1]], points[v[2]],
+                        points[v[3]]) > 0);
+      for (auto x : v) used[x] = true;
+      for (uint32_t f = 0; f < 4; ++f) {
+        if (n[f] == no_neighbor) {
+          ++boundary_faces;
+          for (auto i : face_vertices[f]) boundary[v[i]] = true;
+          continue;
+        }
+        // Links are symmetric and the shared face has the same vertices.
+        const auto& neighbor = tetrahedra[tetrahedron_of(n[f])];
+        CHECK(neighbor.neighbors[face_of(n[f])] == link(t, f));
+        const auto opposite = neighbor.vertices[face_of(n[f])];
+        CHECK(opposite != v[f]);
+        for (auto i : face_vertices[f])
+          CHECK(find(neighbor.vertices.begin(), neighbor.vertices.end(),
+                     v[i]) != neighbor.vertices.end());
+      }
+    }
+    size_t boundary_vertices = 0;
+    for (auto b : boundary) boundary_vertices += b;
+    CHECK(boundary_faces == 2 * boundary_vertices - 4);
+    for (size_t i = 0; i < 300; ++i) CHECK(used[i]);
+    for (size_t i = 300; i < points.size(); ++i) CHECK(!used[i]);
+
+    // Float circumspheres of flat tetrahedra at the hull are too inaccurate.
+    for (const auto& [v, _] : tetrahedra) {
+      for (uint32_t i = 0; i < points.size(); ++i) {
+        if (find(v.begin(), v.end(), i) != v.end()) continue;
+        CHECK(insphere(points[v[0]], points[v[1]], points[v[2]], points[v[3]],
+                       points[i]) <= 1e-12);
+      }
+    }
+  };
+
+  SUBCASE("Cached Circumspheres") {
+    const auto mesh = compact::triangulation(points);
+    check(mesh.tetrahedra());
+    CHECK(mesh.spheres().size() == mesh.tetrahedra().size());
+  }
+  SUBCASE("Recomputed Circumspheres") {
+    const auto mesh = compact::triangulation<false>(points);
+    check(mesh.tetrahedra());
+  }
+}
+
+TEST_CASE("The compact mesh waits for four points that are not coplanar.") {
+  using namespace delaunay::experimental_3d;
+
+  const vector<point> points{{0, 0, 0}, {0, 0, 0}, {1, 0, 0}, {2, 0, 0},
+                             {0, 1, 0}, {1, 1, 0}, {0, 0, 1}};
+  compact::mesh<> mesh{points};
+  for (uint32_t i = 0; i + 1 < points.size(); ++i) mesh.insert(i);
+  CHECK(mesh.tetrahedra().empty());
+  mesh.insert(points.size() - 1);
+  mesh.compact();
+  // The base square is split into two triangles forming two tetrahedra
+  // with the apex. The collinear point splits one of them.
+  CHECK(mesh.tetrahedra().size() == 3);
+}
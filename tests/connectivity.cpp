@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/bowyer_watson.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::connectivity;
+using delaunay::bowyer_watson::point;
+using delaunay::bowyer_watson::triangle;
+
+TEST_CASE("The connectivity of a triangulation is filled by the engine.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+  const auto random = [&] { return dist(rng); };
+
+  vector<point> points(500);
+  for (auto& p : points) p = point{random(), random()};
+
+  connectivity<3> adjacency{};
+  const auto elements =
+      delaunay::bowyer_watson::experimental::triangulation(points, &adjacency);
+
+  REQUIRE(adjacency.neighbors.size() == elements.size());
+  REQUIRE(adjacency.vertex_offsets.size() == points.size() + 1);
+  REQUIRE(adjacency.vertex_elements.size() == 3 * elements.size());
+
+  // Every vertex lists exactly the triangles referencing it.
+  for (size_t v = 0; v < points.size(); ++v) {
+    for (auto i = adjacency.vertex_offsets[v];
+         i < adjacency.vertex_offsets[v + 1]; ++i) {
+      const auto& t = elements[adjacency.vertex_elements[i]];
+      CHECK(find(begin(t), end(t), v) != end(t));
+    }
+  }
+
+  // Neighbors are symmetric and share the edge opposite to the vertex.
+  size_t boundary_edges = 0;
+  for (size_t i = 0; i < elements.size(); ++i) {
+    for (size_t k = 0; k < 3; ++k) {
+      const auto j = adjacency.neighbors[i][k];
+      if (j == adjacency.none) {
+        ++boundary_edges;
+        continue;
+      }
+      const auto& n = adjacency.neighbors[j];
+      CHECK(find(begin(n), end(n), i) != end(n));
+      const auto a = elements[i][(k + 1) % 3];
+      const auto b = elements[i][(k + 2) % 3];
+      CHECK(find(begin(elements[j]), end(elements[j]), a) != end(elements[j]));
+      CHECK(find(begin(elements[j]), end(elements[j]), b) != end(elements[j]));
+    }
+  }
+  // Euler: The boundary edges close the triangulated disk.
+  CHECK(elements.size() == 2 * points.size() - 2 - boundary_edges);
+
+  // Computing the connectivity afterwards yields the same result.
+  const auto other = delaunay::make_connectivity<3>(elements, points.size());
+  CHECK(other.neighbors == adjacency.neighbors);
+  CHECK(other.vertex_offsets == adjacency.vertex_offsets);
+}
@@ -0,0 +1,49 @@
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/convex_hull.hpp>
+#include <lyrahgames/delaunay/delaunay.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::connectivity;
+using delaunay::experimental_3d::point;
+
+TEST_CASE("The convex hull of points in 3D is built incrementally.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{-1, 1};
+
+  vector<point> points(2000);
+  for (auto& p : points) p = point{dist(rng), dist(rng), dist(rng)};
+
+  connectivity<3> adjacency{};
+  const auto faces = delaunay::convex_hull::triangulation(points, &adjacency);
+
+  // No point lies outside of a face.
+  vector<char> vertex(points.size(), false);
+  for (const auto& f : faces) {
+    for (auto v : f) vertex[v] = true;
+    const auto a = delaunay::coordinates<3>(points[f[0]]);
+    const auto b = delaunay::coordinates<3>(points[f[1]]);
+    const auto c = delaunay::coordinates<3>(points[f[2]]);
+    for (size_t i = 0; i < points.size(); ++i) {
+      if ((i == f[0]) || (i == f[1]) || (i == f[2])) continue;
+      CHECK(delaunay::convex_hull::detail::orientation(
+                a, b, c, delaunay::coordinates<3>(points[i])) <= 0);
+    }
+  }
+  size_t vertices = 0;
+  for (auto v : vertex) vertices += v;
+
+  // The hull is a closed triangulated sphere.
+  CHECK(faces.size() == 2 * vertices - 4);
+  for (const auto& n : adjacency.neighbors)
+    for (auto f : n) CHECK(f != adjacency.none);
+
+  SUBCASE("Coplanar points have no hull.") {
+    for (auto& p : points) p.z = 0;
+    CHECK(delaunay::convex_hull::triangulation(points).empty());
+  }
+}
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/distributed.hpp>
+#include <lyrahgames/delaunay/tiled.hpp>
+//
+#ifdef LYRAHGAMES_DELAUNAY_SOCKETS
+#include <sys/wait.h>
+#endif
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::distributed::point;
+using delaunay::distributed::triangle;
+
+namespace {
+
+// Rotate every triangle to start at its smallest index.
+auto normalized(vector<triangle> triangles) {
+  for (auto& t : triangles)
+    rotate(t.begin(), min_element(t.begin(), t.end()), t.end());
+  sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+
+}  // namespace
+
+TEST_CASE("Ranks triangulate their slabs and exchange halo points.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{-1, 1};
+
+  vector<point> points(3000);
+  for (auto& p : points) p = point{dist(rng), dist(rng)};
+  // The single tile uses the same super triangle.
+  const auto expected = normalized(
+      delaunay::tiled::triangulation(points, nullptr, points.size()));
+
+  // Rank r gets a contiguous part of the points to keep their indices.
+  const auto part = [&points](size_t rank, size_t ranks) {
+    return vector<point>(points.begin() + rank * points.size() / ranks,
+                         points.begin() + (rank + 1) * points.size() / ranks);
+  };
+
+  SUBCASE("Local Transport") {
+    for (size_t ranks : {1, 2, 5}) {
+      auto transports = delaunay::distributed::local_transport::create(ranks);
+      vector<vector<triangle>> results(ranks);
+      vector<thread> threads{};
+      for (size_t r = 0; r < ranks; ++r)
+        threads.emplace_back([&, r] {
+          results[r] = delaunay::distributed::triangulation(transports[r],
+                                                            part(r, ranks));
+        });
+      for (auto& t : threads) t.join();
+      vector<triangle> triangles{};
+      for (const auto& x : results)
+        triangles.insert(triangles.end(), x.begin(), x.end());
+      CHECK(normalized(triangles) == expected);
+    }
+  }
+
+#ifdef LYRAHGAMES_DELAUNAY_SOCKETS
+  SUBCASE("Socket Transport") {
+    const size_t ranks = 3;
+    auto transports = delaunay::distributed::socket_transport::create(ranks);
+    vector<pid_t> children{};
+    for (size_t r = 1; r < ranks; ++r) {
+      const auto pid = fork();
+      REQUIRE(pid >= 0);
+      if (pid > 0) {
+        children.push_back(pid);
+        continue;
+      }
+      // Every child sends its triangles back to the first rank.
+      auto transport = std::move(transports[r]);
+      transports.clear();
+      const auto result =
+          delaunay::distributed::triangulation(transport, part(r, ranks));
+      delaunay::distributed::message m(result.size() * sizeof(triangle));
+      memcpy(m.data(), result.data(), m.size());
+      transport.send(0, std::move(m));
+      _exit(0);
+    }
+    auto transport = std::move(transports[0]);
+    transports.clear();
+    auto triangles =
+        delaunay::distributed::triangulation(transport, part(0, ranks));
+    for (size_t r = 1; r < ranks; ++r) {
+      const auto m = transport.receive(r);
+      const auto first = triangles.size();
+      triangles.resize(first + m.size() / sizeof(triangle));
+      memcpy(triangles.data() + first, m.data(), m.size());
+    }
+    for (auto pid : children) {
+      int status = 0;
+      waitpid(pid, &status, 0);
+      CHECK(WIFEXITED(status));
+    }
+    CHECK(normalized(triangles) == expected);
+  }
+#endif
+}
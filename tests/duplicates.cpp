@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/duplicates.hpp>
+#include <lyrahgames/delaunay/guibas_stolfi.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::float32x2;
+using delaunay::guibas_stolfi::edge_algebra;
+
+TEST_CASE("Consecutive Hilbert keys belong to neighboring cells.") {
+  const auto check = [](auto dim) {
+    constexpr size_t N = decltype(dim)::value;
+    constexpr size_t bits = 3;
+    constexpr size_t cells = size_t{1} << (N * bits);
+    vector<array<uint32_t, N>> inverse(cells);
+    vector<bool> visited(cells, false);
+    for (size_t i = 0; i < cells; ++i) {
+      array<uint32_t, N> x{};
+      for (size_t k = 0, c = i; k < N; ++k, c >>= bits)
+        x[k] = c & ((1 << bits) - 1);
+      const auto key = delaunay::hilbert_key<N>(x, bits);
+      REQUIRE(key < cells);
+      CHECK(!visited[key]);
+      visited[key] = true;
+      inverse[key] = x;
+    }
+    for (size_t i = 1; i < cells; ++i) {
+      int distance = 0;
+      for (size_t k = 0; k < N; ++k)
+        distance += abs(int(inverse[i][k]) - int(inverse[i - 1][k]));
+      CHECK(distance == 1);
+    }
+  };
+  check(integral_constant<size_t, 2>{});
+  check(integral_constant<size_t, 3>{});
+}
+
+TEST_CASE("The parallel radix sort is a stable sort.") {
+  mt19937 rng{random_device{}()};
+  uniform_int_distribution<uint64_t> dist{0, 1000};
+
+  const size_t n = 100000;
+  vector<uint64_t> keys(n);
+  for (auto& k : keys) k = dist(rng) << 40 | dist(rng);
+  vector<size_t> values(n);
+  for (size_t i = 0; i < n; ++i) values[i] = i;
+
+  vector<size_t> expected = values;
+  stable_sort(begin(expected), end(expected),
+              [&](auto i, auto j) { return keys[i] < keys[j]; });
+
+  delaunay::radix_sort(keys, values);
+  CHECK(values == expected);
+  CHECK(is_sorted(begin(keys), end(keys)));
+}
+
+TEST_CASE("Duplicated points are collapsed and remapped.") {
+  const auto seed = random_device{}();
+  CAPTURE(seed);
+  mt19937 rng{seed};
+  uniform_real_distribution<float> dist{0, 1};
+  const auto random = [&] { return dist(rng); };
+
+  const size_t unique = 10000;
+  vector<float32x2> points(unique);
+  for (auto& p : points) p = float32x2{random(), random()};
+  uniform_int_distribution<size_t> index{0, unique - 1};
+  for (size_t i = 0; i < unique; ++i) points.push_back(points[index(rng)]);
+  // Negative and positive zero are equal although their bits differ.
+  points.push_back({0.0f, 0.5f});
+  points.push_back({-0.0f, 0.5f});
+
+  const auto result = delaunay::remove_duplicates(points);
+  REQUIRE(result.points.size() == unique + 1);
+  REQUIRE(result.remap.size() == points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto& p = result.points[result.remap[i]];
+    CHECK(p[0] == points[i][0]);
+    CHECK(p[1] == points[i][1]);
+    // The representative is the first occurrence in the input.
+    CHECK(result.origin[result.remap[i]] <= i);
+  }
+  for (size_t i = 0; i < result.origin.size(); ++i)
+    CHECK(result.remap[result.origin[i]] == i);
+
+  SUBCASE("Points closer than epsilon are collapsed as well.") {
+    const float epsilon = 1e-5f;
+    auto jittered = result.points;
+    for (const auto& p : result.points)
+      jittered.push_back(p + float32x2{0.2f * epsilon, -0.2f * epsilon});
+    const auto near = delaunay::remove_duplicates(jittered, epsilon);
+    CHECK(near.points.size() <= result.points.size());
+    for (size_t i = 0; i < result.points.size(); ++i)
+      CHECK(near.remap[i] == near.remap[i + result.points.size()]);
+  }
+
+  SUBCASE("Long runs of equal Hilbert keys are collapsed.") {
+    // A far away outlier makes the grid so coarse that all other points
+    // share a single cell and their keys form one run. Scaling by a power
+    // of two keeps distinct points distinct.
+    auto clustered = points;
+    for (auto& p : clustered) p = (1.0f / 1024) * p;
+    clustered.push_back({1e30f, 1e30f});
+    const auto run = delaunay::remove_duplicates(clustered);
+    REQUIRE(run.points.size() == result.points.size() + 1);
+    for (size_t i = 0; i < points.size(); ++i) {
+      CHECK(run.origin[run.remap[i]] == result.origin[result.remap[i]]);
+      const auto& p = run.points[run.remap[i]];
+      CHECK(p[0] == clustered[i][0]);
+      CHECK(p[1] == clustered[i][1]);
+    }
+  }
+
+  SUBCASE("The quad-edge engine ignores duplicates.") {
+    vector<float32x2> vertices = points;
+    vertices.push_back({-10, -10});
+    vertices.push_back({10, -10});
+    vertices.push_back({0, 20});
+    const auto n = vertices.size();
+    edge_algebra diagram{};
+    diagram.edges.reserve(3 * n);
+    diagram.set_super_triangle(&vertices[n - 3], &vertices[n - 2],
+                               &vertices[n - 1]);
+    for (size_t i = 0; i < n - 3; ++i) diagram.add(&vertices[i]);
+    // Every unique point adds three edges.
+    CHECK(diagram.edges.size() == 3 + 3 * result.points.size());
+  }
+}
+
+TEST_CASE("Chains of points closer than epsilon form a single group.") {
+  // The first and second point are farther apart than epsilon but both are
+  // closer than epsilon to the third point.
+  const float epsilon = 1e-3f;
+  const vector<float32x2> points{{0.5f, 0.5f},
+                                 {0.5f + 1.05f * epsilon, 0.5f},
+                                 {0.5f + 0.85f * epsilon, 0.5f},
+                                 {0.0f, 0.0f},
+                                 {1.0f, 1.0f}};
+  const auto result = delaunay::remove_duplicates(points, epsilon);
+  REQUIRE(result.points.size() == 3);
+  CHECK(result.remap[0] == result.remap[1]);
+  CHECK(result.remap[1] == result.remap[2]);
+  CHECK(result.remap[3] != result.remap[0]);
+  CHECK(result.remap[4] != result.remap[0]);
+  CHECK(result.remap[3] != result.remap[4]);
+  for (size_t i = 0; i < points.size(); ++i)
+    CHECK(result.origin[result.remap[i]] == (i < 3 ? 0 : i));
+}
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <array>
+#include <random>
+#include <stdexcept>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/bowyer_watson.hpp>
+#include <lyrahgames/delaunay/fixed.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::fixed::point;
+using delaunay::fixed::triangle;
+
+namespace {
+
+// Four points on the convex hull and one inside of it.
+constexpr std::array<point, 5> pentagon{
+    point{0, 0}, point{4, 0}, point{4, 3}, point{0, 3.5f}, point{1.5f, 1.2f}};
+constexpr auto pentagon_triangles = delaunay::fixed::triangulation(pentagon);
+static_assert(pentagon_triangles.size() == 4);
+static_assert(std::all_of(pentagon_triangles.begin(), pentagon_triangles.end(),
+                          [](const triangle& t) {
+                            return counterclockwise(pentagon[t[0]],
+                                                    pentagon[t[1]],
+                                                    pentagon[t[2]]);
+                          }));
+
+// Points rounded to a circle of radius 128 around (128, 3072). Rounding
+// errors of the float predicates make some cavities non-star-shaped and
+// their boundaries exceed the capacities, which only hold for exact
+// predicates. Such points have to be skipped without writing out of bounds,
+// which the constant evaluation would reject.
+constexpr std::array<point, 32> circle{
+    point{0x1.60ecb4p+6, 0x1.8f354ap+11}, point{0x1.fa60bp+7, 0x1.7caa48p+11},
+    point{0x1.a36afap+7, 0x1.73af2p+11}, point{0x1.9824a8p+6, 0x1.8faad8p+11},
+    point{0x1.43a1ecp+6, 0x1.8ee0b8p+11}, point{0x1.451364p+5, 0x1.8bb18ap+11},
+    point{0x1.84c36cp+6, 0x1.70786cp+11}, point{0x1.b1a16p+7, 0x1.747a76p+11},
+    point{0x1.4ec4dp+3, 0x1.79aa2ap+11}, point{0x1.8242cp+5, 0x1.737b58p+11},
+    point{0x1.7cc46p+5, 0x1.738cf6p+11}, point{0x1.3dc384p+7, 0x1.8f87p+11},
+    point{0x1.4f3d2p+4, 0x1.773a56p+11}, point{0x1.f06be4p+6, 0x1.8ffe1ap+11},
+    point{0x1.f7a7c4p+7, 0x1.840d44p+11}, point{0x1.609c5cp+6, 0x1.8f3478p+11},
+    point{0x1.70bb5ap+7, 0x1.8e5d7ap+11}, point{0x1.2eedfcp+7, 0x1.70456ap+11},
+    point{0x1.d4ee4cp+7, 0x1.88e1d4p+11}, point{0x1.9cdfb8p+5, 0x1.73296cp+11},
+    point{0x1.d6752ap+7, 0x1.88bccap+11}, point{0x1.a0d8ecp+7, 0x1.8c728ap+11},
+    point{0x1.0cb258p+4, 0x1.87ec3p+11}, point{0x1.5e53ecp+6, 0x1.8f2e7p+11},
+    point{0x1.ae0eaap+7, 0x1.8bbb92p+11}, point{0x1.61da76p+6, 0x1.70c84ap+11},
+    point{0x1.ffff2ep+7, 0x1.7feb82p+11}, point{0x1.939f7p+7, 0x1.8d1264p+11},
+    point{0x1.fe6d7cp+7, 0x1.81c544p+11}, point{0x1.2037cp+4, 0x1.77d0ccp+11},
+    point{0x1.bd75f4p+5, 0x1.8d33a2p+11}, point{0x1.08d3ep+7, 0x1.8ffd9p+11}};
+constexpr auto circle_triangles = delaunay::fixed::triangulation(circle);
+static_assert(circle_triangles.size() <= circle_triangles.capacity());
+
+// Rotate every triangle to start at its smallest index.
+template <typename Triangles>
+auto normalized(const Triangles& triangles) {
+  vector<triangle> result{};
+  for (const auto& x : triangles) {
+    triangle t{x[0], x[1], x[2]};
+    rotate(t.begin(), min_element(t.begin(), t.end()), t.end());
+    result.push_back(t);
+  }
+  sort(result.begin(), result.end());
+  return result;
+}
+
+}  // namespace
+
+TEST_CASE("Small point sets are triangulated without heap allocations.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{-1, 1};
+
+  constexpr size_t capacity = 64;
+  for (size_t n = 0; n <= capacity; ++n) {
+    vector<point> points(n);
+    for (auto& p : points) p = point{dist(rng), dist(rng)};
+    // Duplicated points are skipped.
+    if (n > 8) points[n - 1] = points[n / 2];
+    const auto triangles =
+        delaunay::fixed::triangulation<capacity>(points.data(), n);
+    CHECK(normalized(triangles) ==
+          normalized(delaunay::bowyer_watson::ghost::triangulation(points)));
+  }
+
+  // Beyond their capacity, static vectors throw instead of writing.
+  delaunay::fixed::static_vector<size_t, 2> indices{};
+  indices.push_back(0);
+  indices.push_back(1);
+  CHECK(indices.full());
+  CHECK_THROWS_AS(indices.push_back(2), length_error);
+
+  vector<point> points(capacity + 1);
+  CHECK_THROWS_AS(
+      delaunay::fixed::triangulation<capacity>(points.data(), points.size()),
+      length_error);
+}
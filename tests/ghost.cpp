@@ -0,0 +1,52 @@
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/bowyer_watson.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::connectivity;
+
+TEST_CASE("The ghost engine triangulates the whole convex hull in 2D.") {
+  using delaunay::bowyer_watson::point;
+
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+  const auto random = [&] { return dist(rng); };
+
+  vector<point> points(500);
+  for (auto& p : points) p = point{random(), random()};
+  // Duplicated points are ignored.
+  for (size_t i = 0; i < 20; ++i) points[points.size() - 1 - i] = points[i];
+  const size_t unique = points.size() - 20;
+
+  connectivity<3> adjacency{};
+  const auto elements =
+      delaunay::bowyer_watson::ghost::triangulation(points, &adjacency);
+
+  size_t boundary_edges = 0;
+  for (const auto& n : adjacency.neighbors)
+    for (auto j : n) boundary_edges += (j == adjacency.none);
+  CHECK(elements.size() == 2 * unique - 2 - boundary_edges);
+
+  for (const auto& t : elements) {
+    const auto& a = points[t[0]];
+    const auto& b = points[t[1]];
+    const auto& c = points[t[2]];
+    CHECK(counterclockwise(a, b, c));
+    // No point lies strictly inside the circumcircle of a triangle.
+    for (size_t i = 0; i < unique; ++i) {
+      if ((i == t[0]) || (i == t[1]) || (i == t[2])) continue;
+      const auto& p = points[i];
+      const auto u = a - p;
+      const auto v = b - p;
+      const auto w = c - p;
+      const auto det = dot(u, u) * (v[0] * w[1] - v[1] * w[0]) -
+                       dot(v, v) * (u[0] * w[1] - u[1] * w[0]) +
+                       dot(w, w) * (u[0] * v[1] - u[1] * v[0]);
+      CHECK(det < 1e-5f);
+    }
+  }
+}
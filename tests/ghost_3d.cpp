@@ -0,0 +1,50 @@
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/delaunay.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::connectivity;
+
+TEST_CASE("The ghost engine triangulates the whole convex hull in 3D.") {
+  using namespace delaunay::experimental_3d;
+
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+  const auto random = [&] { return dist(rng); };
+
+  vector<point> points(300);
+  for (auto& p : points) p = point{random(), random(), random()};
+
+  connectivity<4> adjacency{};
+  const auto elements = ghost::triangulation(points, &adjacency);
+  REQUIRE(!elements.empty());
+
+  // Every vertex is used and the boundary faces form a closed
+  // triangulated sphere: F = 2V - 4 for its V vertices.
+  size_t boundary_faces = 0;
+  vector<bool> boundary(points.size(), false);
+  for (size_t i = 0; i < elements.size(); ++i) {
+    for (size_t k = 0; k < 4; ++k) {
+      if (adjacency.neighbors[i][k] != adjacency.none) continue;
+      ++boundary_faces;
+      for (size_t j = 1; j < 4; ++j) boundary[elements[i][(k + j) % 4]] = true;
+    }
+  }
+  size_t boundary_vertices = 0;
+  for (auto b : boundary) boundary_vertices += b;
+  CHECK(boundary_faces == 2 * boundary_vertices - 4);
+  for (size_t v = 0; v < points.size(); ++v) CHECK(adjacency.degree(v) > 0);
+
+  for (const auto& t : elements) {
+    const auto s =
+        circumsphere(points[t[0]], points[t[1]], points[t[2]], points[t[3]]);
+    for (size_t i = 0; i < points.size(); ++i) {
+      if ((i == t[0]) || (i == t[1]) || (i == t[2]) || (i == t[3])) continue;
+      CHECK(sqnorm(points[i] - s.c) >= s.r2 * (1 - 1e-4f));
+    }
+  }
+}
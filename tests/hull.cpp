@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/guibas_stolfi.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::guibas_stolfi::edge_algebra;
+using delaunay::guibas_stolfi::point;
+
+TEST_CASE("The quad-edge engine returns its boundary counterclockwise.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{-1, 1};
+  const auto random = [&] { return dist(rng); };
+
+  const size_t n = 1000;
+  vector<point> points(n);
+  for (auto& p : points) p = point{random(), random()};
+  points[0] = {-10, -10};
+  points[1] = {10, -10};
+  points[2] = {0, 20};
+
+  edge_algebra diagram{};
+  diagram.edges.reserve(3 * n);
+  diagram.set_super_triangle(&points[0], &points[1], &points[2]);
+  for (size_t i = 3; i < n; ++i) diagram.add(&points[i]);
+
+  const auto hull = diagram.hull(points.data());
+  REQUIRE(hull.size() >= 3);
+
+  // The boundary polygon is positively oriented.
+  float area = 0;
+  for (size_t i = 0; i < hull.size(); ++i) {
+    const auto& p = points[hull[i]];
+    const auto& q = points[hull[(i + 1) % hull.size()]];
+    area += p[0] * q[1] - p[1] * q[0];
+  }
+  CHECK(area > 0);
+
+  // Compute the convex hull by Andrew's monotone chain algorithm.
+  vector<size_t> indices{};
+  for (size_t i = 3; i < n; ++i) indices.push_back(i);
+  sort(begin(indices), end(indices), [&](auto i, auto j) {
+    return (points[i][0] < points[j][0]) ||
+           ((points[i][0] == points[j][0]) && (points[i][1] < points[j][1]));
+  });
+  vector<size_t> convex(2 * indices.size());
+  size_t k = 0;
+  for (size_t i = 0; i < indices.size(); ++i) {
+    while ((k >= 2) && !counterclockwise(points[convex[k - 2]],
+                                         points[convex[k - 1]],
+                                         points[indices[i]]))
+      --k;
+    convex[k++] = indices[i];
+  }
+  for (size_t i = indices.size() - 1, t = k + 1; i-- > 0;) {
+    while ((k >= t) && !counterclockwise(points[convex[k - 2]],
+                                         points[convex[k - 1]],
+                                         points[indices[i]]))
+      --k;
+    convex[k++] = indices[i];
+  }
+  convex.resize(k - 1);
+
+  // Every vertex of the convex hull is part of the boundary
+  // and they appear in the same cyclic order.
+  auto it = find(begin(hull), end(hull), convex[0]);
+  REQUIRE(it != end(hull));
+  const size_t start = it - begin(hull);
+  size_t offset = start;
+  for (size_t i = 1; i < convex.size(); ++i) {
+    size_t j = 1;
+    while ((j < hull.size()) &&
+           (hull[(offset + j) % hull.size()] != convex[i]))
+      ++j;
+    REQUIRE(j < hull.size());
+    offset += j;
+  }
+  CHECK(offset - start < hull.size());
+}
@@ -0,0 +1,93 @@
+#include <cmath>
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/bowyer_watson.hpp>
+#include <lyrahgames/delaunay/interpolation.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::float32x2;
+
+TEST_CASE("Scattered data is interpolated onto a strided raster.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+
+  std::vector<float32x2> points(1000);
+  for (auto& p : points) p = float32x2{dist(rng), dist(rng)};
+  // The corners make the convex hull cover the unit square.
+  // The ghost engine triangulates the whole convex hull.
+  points.push_back({0, 0});
+  points.push_back({1, 0});
+  points.push_back({0, 1});
+  points.push_back({1, 1});
+  delaunay::connectivity<3> adjacency{};
+  const auto triangles =
+      delaunay::bowyer_watson::ghost::triangulation(points, &adjacency);
+
+  const auto linear = [](const float32x2& x) {
+    return 2 * x[0] - 3 * x[1] + 1;
+  };
+  const auto quadratic = [](const float32x2& x) {
+    return x[0] * x[0] - 2 * x[0] * x[1] + 0.5f * x[1] * x[1] + x[0];
+  };
+  std::vector<float> linear_values{};
+  std::vector<float> quadratic_values{};
+  std::vector<float32x2> gradients{};
+  for (const auto& p : points) {
+    linear_values.push_back(linear(p));
+    quadratic_values.push_back(quadratic(p));
+    gradients.push_back({2 * p[0] - 2 * p[1] + 1, -2 * p[0] + p[1]});
+  }
+
+  // The buffer is stored column by column to test the strides.
+  const size_t columns = 120;
+  const size_t rows = 80;
+  std::vector<float> buffer(columns * rows);
+  delaunay::raster grid{};
+  grid.origin = {-0.1f, -0.1f};
+  grid.spacing = {1.2f / columns, 1.2f / rows};
+  grid.columns = columns;
+  grid.rows = rows;
+  grid.data = buffer.data();
+  grid.row_stride = 1;
+  grid.column_stride = rows;
+  grid.outside = -1000;
+
+  const auto check = [&](const auto& f, float tolerance) {
+    for (size_t j = 0; j < rows; ++j) {
+      for (size_t i = 0; i < columns; ++i) {
+        const float32x2 x{grid.origin[0] + i * grid.spacing[0],
+                          grid.origin[1] + j * grid.spacing[1]};
+        const auto value = buffer[i * rows + j];
+        const auto inside =
+            (0 <= x[0]) && (x[0] <= 1) && (0 <= x[1]) && (x[1] <= 1);
+        // Cells on the boundary may be classified either way.
+        const auto radius = max(abs(x[0] - 0.5f), abs(x[1] - 0.5f));
+        if (abs(radius - 0.5f) < 1e-3f) continue;
+        if (inside)
+          CHECK(value == doctest::Approx(f(x)).epsilon(tolerance));
+        else
+          CHECK(value == grid.outside);
+      }
+    }
+  };
+
+  // All methods reproduce linear data.
+  delaunay::linear_interpolation(points, triangles, adjacency, linear_values,
+                                 grid);
+  check(linear, 1e-4);
+  delaunay::natural_neighbor_interpolation(points, triangles, adjacency,
+                                           linear_values, grid);
+  check(linear, 1e-4);
+  delaunay::clough_tocher_interpolation(points, triangles, adjacency,
+                                        linear_values, grid);
+  check(linear, 1e-4);
+
+  // With exact gradients, Clough-Tocher reproduces quadratic data.
+  delaunay::clough_tocher_interpolation(points, triangles, adjacency,
+                                        quadratic_values, grid, &gradients);
+  check(quadratic, 1e-4);
+}
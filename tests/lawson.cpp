@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/lawson.hpp>
+#include <lyrahgames/delaunay/tiled.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::lawson::point;
+
+namespace {
+
+// Rotate every triangle to start at its smallest index.
+auto normalized(vector<delaunay::lawson::triangle> triangles) {
+  for (auto& t : triangles)
+    rotate(t.begin(), min_element(t.begin(), t.end()), t.end());
+  sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+
+}  // namespace
+
+TEST_CASE("Lawson flips construct the Delaunay triangulation.") {
+  static_assert(sizeof(delaunay::quad_edge_algebra32::edge) * 4 == 32);
+
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{-1, 1};
+
+  vector<point> points(5000);
+  for (auto& p : points) p = point{dist(rng), dist(rng)};
+  // Duplicated points are skipped.
+  points.push_back(points[11]);
+
+  // The quad-edge engine serves as reference.
+  const auto expected = normalized(
+      delaunay::tiled::triangulation(points, nullptr, points.size()));
+  REQUIRE(!expected.empty());
+
+  delaunay::connectivity<3> adjacency{};
+  const auto triangles = delaunay::lawson::triangulation(points, &adjacency);
+  CHECK(adjacency.neighbors.size() == triangles.size());
+  CHECK(normalized(triangles) == expected);
+
+  SUBCASE("Edges can be addressed by 64-bit indices.") {
+    CHECK(normalized(delaunay::lawson::triangulation<size_t>(points)) ==
+          expected);
+  }
+
+  SUBCASE("Edges can be addressed by 16-bit indices for small sets.") {
+    CHECK(normalized(delaunay::lawson::triangulation<uint16_t>(points)) ==
+          expected);
+    points.resize(6000, points[0]);
+    CHECK_THROWS_AS(delaunay::lawson::triangulation<uint16_t>(points),
+                    length_error);
+  }
+}
+
+TEST_CASE("Lawson flips handle points on edges of a grid.") {
+  vector<point> points{};
+  for (int i = 0; i < 20; ++i)
+    for (int j = 0; j < 20; ++j) points.push_back(point{float(i), float(j)});
+
+  const auto triangles = delaunay::lawson::triangulation(points);
+  // Every triangulation of the grid consists of two triangles per cell.
+  CHECK(triangles.size() == 2 * 19 * 19);
+  for (const auto& [a, b, c] : triangles) {
+    CHECK(delaunay::counterclockwise(points[a], points[b], points[c]));
+    for (const auto& x : points)
+      CHECK(!delaunay::guibas_stolfi::inside_circumcircle(
+          points[a], points[b], points[c], x));
+  }
+}
+
+TEST_CASE("Lawson flips restore the Delaunay property of a mesh.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> jitter{-0.2f, 0.2f};
+
+  // A jittered grid whose cells are split along the same diagonal is valid
+  // but not Delaunay, as long as the jitter keeps all triangles positive.
+  // The border points stay on the lines of the box, which is the convex hull.
+  constexpr size_t size = 100;
+  vector<point> points{};
+  for (size_t i = 0; i < size; ++i)
+    for (size_t j = 0; j < size; ++j) {
+      const bool border_i = (i == 0) || (i == size - 1);
+      const bool border_j = (j == 0) || (j == size - 1);
+      points.push_back(point{float(i) + (border_i ? 0 : jitter(rng)),
+                             float(j) + (border_j ? 0 : jitter(rng))});
+    }
+  vector<delaunay::lawson::triangle> mesh{};
+  for (size_t i = 0; i + 1 < size; ++i)
+    for (size_t j = 0; j + 1 < size; ++j) {
+      const auto v = i * size + j;
+      mesh.push_back({v, v + size, v + size + 1});
+      mesh.push_back({v, v + size + 1, v + 1});
+    }
+
+  const auto expected = normalized(
+      delaunay::tiled::triangulation(points, nullptr, points.size()));
+  delaunay::statistics statistics{};
+  delaunay::connectivity<3> adjacency{};
+  const auto triangles =
+      delaunay::lawson::triangulation(points, mesh, &adjacency, statistics);
+  CHECK(adjacency.neighbors.size() == triangles.size());
+  CHECK(normalized(triangles) == expected);
+  CHECK(statistics.flips > 0);
+
+  SUBCASE("Delaunay meshes need no flips.") {
+    delaunay::statistics again{};
+    CHECK(normalized(delaunay::lawson::triangulation(points, triangles,
+                                                     nullptr, again)) ==
+          expected);
+    CHECK(again.flips == 0);
+  }
+
+  SUBCASE("Holes of the mesh are kept.") {
+    mesh.erase(mesh.begin() + mesh.size() / 2);
+    const auto holed = delaunay::lawson::triangulation(points, mesh);
+    CHECK(holed.size() == mesh.size());
+    for (const auto& [a, b, c] : holed)
+      CHECK(delaunay::counterclockwise(points[a], points[b], points[c]));
+  }
+
+  SUBCASE("Meshes have to be manifold.") {
+    mesh.push_back(mesh.front());
+    CHECK_THROWS_AS(delaunay::lawson::triangulation(points, mesh),
+                    invalid_argument);
+  }
+}
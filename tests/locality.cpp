@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/delaunay.hpp>
+#include <lyrahgames/delaunay/locality.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+
+namespace {
+
+// Average number of vertex cache misses per element
+// for a FIFO cache of the given size.
+template <typename Elements>
+double cache_misses(const Elements& elements, size_t vertex_count,
+                    size_t cache_size = 16) {
+  vector<size_t> entered(vertex_count, 0);
+  size_t time = cache_size + 1;
+  size_t misses = 0;
+  for (const auto& e : elements)
+    for (auto v : e) {
+      if ((entered[v] != 0) && (time - entered[v] <= cache_size)) continue;
+      ++misses;
+      entered[v] = time++;
+    }
+  return static_cast<double>(misses) / elements.size();
+}
+
+// Checks that the renumbered mesh consists of the same elements.
+template <typename Point, typename Elements>
+void check_renumbering(const vector<Point>& points,
+                       const vector<Point>& renumbered_points,
+                       const Elements& elements,
+                       const Elements& renumbered_elements,
+                       const delaunay::renumbering& permutation) {
+  REQUIRE(permutation.vertices.size() == points.size());
+  REQUIRE(permutation.elements.size() == elements.size());
+  auto vertices = permutation.vertices;
+  sort(vertices.begin(), vertices.end());
+  for (size_t i = 0; i < vertices.size(); ++i) CHECK(vertices[i] == i);
+
+  const auto equal = [](const Point& p, const Point& q) {
+    return (p.x == q.x) && (p.y == q.y);
+  };
+  for (size_t i = 0; i < points.size(); ++i)
+    CHECK(equal(renumbered_points[i], points[permutation.vertices[i]]));
+  for (size_t i = 0; i < elements.size(); ++i) {
+    const auto& e = renumbered_elements[i];
+    const auto& old = elements[permutation.elements[i]];
+    for (size_t k = 0; k < e.size(); ++k)
+      CHECK(permutation.vertices[e[k]] == old[k]);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Renumbering improves the locality of triangles.") {
+  using delaunay::point;
+
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{-1, 1};
+  vector<point> points(2000);
+  for (auto& p : points) p = point{dist(rng), dist(rng)};
+
+  // The legacy engine reports its triangles in hash-bucket order.
+  const auto triangles = delaunay::triangulation(points);
+  REQUIRE(!triangles.empty());
+
+  auto renumbered_points = points;
+  auto renumbered_triangles = triangles;
+  delaunay::connectivity<3> adjacency{};
+  const auto permutation = delaunay::renumber(
+      renumbered_points, renumbered_triangles, &adjacency);
+  check_renumbering(points, renumbered_points, triangles,
+                    renumbered_triangles, permutation);
+  CHECK(adjacency.neighbors.size() == triangles.size());
+
+  CHECK(cache_misses(renumbered_triangles, points.size()) < 1.0);
+  CHECK(cache_misses(renumbered_triangles, points.size()) <
+        cache_misses(triangles, points.size()) / 2);
+}
+
+TEST_CASE("Renumbering improves the locality of tetrahedra.") {
+  using namespace delaunay::experimental_3d;
+
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+  vector<point> points(1000);
+  for (auto& p : points) p = point{dist(rng), dist(rng), dist(rng)};
+
+  const auto tetrahedra = ghost::triangulation(points);
+  REQUIRE(!tetrahedra.empty());
+
+  auto renumbered_points = points;
+  auto renumbered_tetrahedra = tetrahedra;
+  const auto permutation =
+      delaunay::renumber(renumbered_points, renumbered_tetrahedra);
+  check_renumbering(points, renumbered_points, tetrahedra,
+                    renumbered_tetrahedra, permutation);
+  CHECK(cache_misses(renumbered_tetrahedra, points.size(), 32) <
+        cache_misses(tetrahedra, points.size(), 32) / 2);
+}
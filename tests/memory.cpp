@@ -0,0 +1,46 @@
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/bowyer_watson.hpp>
+#include <lyrahgames/delaunay/memory.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::memory_usage;
+using delaunay::tracking_allocator;
+using delaunay::bowyer_watson::point;
+
+TEST_CASE("Engines report their memory usage by the tracking allocator.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+  const auto random = [&] { return dist(rng); };
+
+  vector<point> points(1000);
+  for (auto& p : points) p = point{random(), random()};
+
+  const auto reference =
+      delaunay::bowyer_watson::experimental::triangulation(points);
+
+  memory_usage() = {};
+  {
+    const auto elements =
+        delaunay::bowyer_watson::experimental::triangulation<
+            tracking_allocator>(points);
+    CHECK(elements.size() == reference.size());
+    for (size_t i = 0; i < elements.size(); ++i)
+      CHECK(elements[i] == reference[i]);
+
+    const auto& usage = memory_usage();
+    CHECK(usage.allocations > 0);
+    // Only the result is still allocated.
+    CHECK(usage.bytes == elements.capacity() * sizeof(elements[0]));
+    // The triangles and their cached predicates are alive at the same time.
+    CHECK(usage.peak_bytes >=
+          elements.size() * (sizeof(elements[0]) + 3 * sizeof(float)));
+    CHECK(usage.total_bytes >= usage.peak_bytes);
+  }
+  CHECK(memory_usage().bytes == 0);
+  CHECK(memory_usage().allocations == memory_usage().deallocations);
+}
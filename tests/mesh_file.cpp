@@ -0,0 +1,99 @@
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/bowyer_watson.hpp>
+#include <lyrahgames/delaunay/mesh_file.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::connectivity;
+using delaunay::mapped_mesh;
+using delaunay::bowyer_watson::point;
+using delaunay::bowyer_watson::triangle;
+
+TEST_CASE("Triangulations can be stored and mapped in the binary format.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+  const auto random = [&] { return dist(rng); };
+
+  vector<point> points(200);
+  for (auto& p : points) p = point{random(), random()};
+  connectivity<3> adjacency{};
+  const auto elements =
+      delaunay::bowyer_watson::experimental::triangulation(points, &adjacency);
+
+  const auto path =
+      (filesystem::temp_directory_path() / "lyrahgames-delaunay-test.mesh")
+          .string();
+
+  SUBCASE("Points and elements only.") {
+    delaunay::save(path, points, elements);
+    mapped_mesh mesh{path};
+    CHECK(mesh.dimension() == 2);
+    CHECK(mesh.element_size() == 3);
+    CHECK(mesh.vertex_count() == points.size());
+    CHECK(mesh.element_count() == elements.size());
+    CHECK(!mesh.has_adjacency());
+    CHECK_THROWS(mesh.vertex_offsets());
+
+    const auto p = mesh.points<point>();
+    for (size_t i = 0; i < points.size(); ++i) {
+      CHECK(p[i][0] == points[i][0]);
+      CHECK(p[i][1] == points[i][1]);
+    }
+    const auto e = mesh.elements<3>();
+    for (size_t i = 0; i < elements.size(); ++i)
+      for (size_t k = 0; k < 3; ++k) CHECK(e[i][k] == elements[i][k]);
+  }
+
+  SUBCASE("Adjacency is stored and loaded.") {
+    delaunay::save(path, points, elements, &adjacency);
+    mapped_mesh mesh{path};
+    REQUIRE(mesh.has_adjacency());
+
+    vector<point> loaded_points{};
+    vector<triangle> loaded_elements{};
+    connectivity<3> loaded_adjacency{};
+    delaunay::load(mesh, loaded_points, loaded_elements, loaded_adjacency);
+    CHECK(loaded_elements == elements);
+    CHECK(loaded_adjacency.neighbors == adjacency.neighbors);
+    CHECK(loaded_adjacency.vertex_offsets == adjacency.vertex_offsets);
+    CHECK(loaded_adjacency.vertex_elements == adjacency.vertex_elements);
+  }
+
+  SUBCASE("Files of other types are rejected.") {
+    {
+      std::FILE* file = std::fopen(path.c_str(), "wb");
+      const char data[256]{"no mesh"};
+      std::fwrite(data, 1, sizeof(data), file);
+      std::fclose(file);
+    }
+    CHECK_THROWS(mapped_mesh{path});
+  }
+
+  SUBCASE("Truncated files and crafted headers are rejected.") {
+    delaunay::save(path, points, elements, &adjacency);
+    const auto size = filesystem::file_size(path);
+
+    // A vertex count of 2^62 makes n * dimension * 4 wrap around to zero.
+    {
+      std::FILE* file = std::fopen(path.c_str(), "r+b");
+      const uint64_t count = uint64_t{1} << 62;
+      std::fseek(file, 32, SEEK_SET);
+      std::fwrite(&count, sizeof(count), 1, file);
+      std::fclose(file);
+    }
+    CHECK_THROWS_AS(mapped_mesh{path}, runtime_error);
+
+    delaunay::save(path, points, elements, &adjacency);
+    filesystem::resize_file(path, size - 8);
+    CHECK_THROWS_AS(mapped_mesh{path}, runtime_error);
+  }
+
+  filesystem::remove(path);
+}
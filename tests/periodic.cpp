@@ -0,0 +1,108 @@
+#include <array>
+#include <cmath>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/delaunay.hpp>
+#include <lyrahgames/delaunay/periodic.hpp>
+#include <lyrahgames/delaunay/vector.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::periodic::domain;
+using delaunay::periodic::element;
+
+namespace {
+
+// Checks that the elements form a closed, positively oriented
+// triangulation of the box whose circumspheres contain no image of a point.
+template <size_t N, typename Point>
+void check_triangulation(const vector<Point>& points, const domain<N>& box,
+                         const vector<element<N>>& elements) {
+  using real = array<double, N>;
+  real period{};
+  for (size_t k = 0; k < N; ++k) period[k] = box.max[k] - box.min[k];
+  const auto position = [&](size_t i, const array<int, N>& o) {
+    auto x = delaunay::coordinates<N>(points[i]);
+    for (size_t k = 0; k < N; ++k) x[k] += o[k] * period[k];
+    return x;
+  };
+
+  map<array<pair<size_t, array<int, N>>, N>, int> facets{};
+  for (const auto& e : elements) {
+    CHECK(e.offsets[0] == array<int, N>{});
+    array<real, N + 1> v{};
+    for (size_t i = 0; i <= N; ++i)
+      v[i] = position(e.vertices[i], e.offsets[i]);
+    CHECK(delaunay::periodic::detail::orientation<N>(v) > 0);
+
+    const auto [center, r2] = delaunay::periodic::detail::circumsphere<N>(v);
+    for (size_t i = 0; i < points.size(); ++i) {
+      // Only the image closest to the center has to be tested.
+      auto x = delaunay::coordinates<N>(points[i]);
+      double d = 0;
+      for (size_t k = 0; k < N; ++k) {
+        x[k] += round((center[k] - x[k]) / period[k]) * period[k];
+        d += (x[k] - center[k]) * (x[k] - center[k]);
+      }
+      CHECK(d > r2 * (1 - 1e-6));
+    }
+
+    for (size_t i = 0; i <= N; ++i)
+      ++facets[delaunay::periodic::detail::facet(e, i)];
+  }
+  for (const auto& [_, count] : facets) CHECK(count == 2);
+}
+
+}  // namespace
+
+TEST_CASE("Points are triangulated periodically in 2D.") {
+  using point = delaunay::float32x2;
+
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> x{0, 2};
+  uniform_real_distribution<float> y{-1, 0};
+
+  const domain<2> box{{0, -1}, {2, 0}};
+  vector<point> points(1000);
+  for (auto& p : points) p = point{x(rng), y(rng)};
+  // Duplicated points are skipped.
+  points.push_back(points[7]);
+
+  const auto triangles = delaunay::periodic::triangulation(points, box);
+  // Every triangulation of the torus consists of twice as many triangles
+  // as vertices.
+  CHECK(triangles.size() == 2 * (points.size() - 1));
+  check_triangulation(points, box, triangles);
+
+  SUBCASE("Points have to lie inside the box.") {
+    points.push_back(point{2, -0.5f});
+    CHECK_THROWS_AS(delaunay::periodic::triangulation(points, box),
+                    invalid_argument);
+  }
+
+  SUBCASE("Too sparse point sets cannot be triangulated.") {
+    points.resize(3);
+    CHECK_THROWS_AS(delaunay::periodic::triangulation(points, box),
+                    runtime_error);
+  }
+}
+
+TEST_CASE("Points are triangulated periodically in 3D.") {
+  using point = delaunay::experimental_3d::point;
+
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+
+  const domain<3> box{{0, 0, 0}, {1, 1, 1}};
+  vector<point> points(400);
+  for (auto& p : points) p = point{dist(rng), dist(rng), dist(rng)};
+
+  const auto tetrahedra = delaunay::periodic::triangulation(points, box);
+  CHECK(!tetrahedra.empty());
+  check_triangulation(points, box, tetrahedra);
+}
@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/bowyer_watson.hpp>
+#include <lyrahgames/delaunay/proximity.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::sqnorm;
+using delaunay::bowyer_watson::point;
+
+TEST_CASE("Proximity graphs are extracted from the Delaunay edges.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+
+  std::vector<point> points(500);
+  for (auto& p : points) p = point{dist(rng), dist(rng)};
+  const auto n = points.size();
+  const auto triangles = delaunay::bowyer_watson::triangulation(points);
+  const auto graph = delaunay::delaunay_graph<3>(triangles, n);
+  const auto distance = [&points](size_t u, size_t v) {
+    return sqnorm(points[u] - points[v]);
+  };
+
+  // Every Delaunay edge is stored in both directions.
+  REQUIRE(graph.vertex_count() == n);
+  for (size_t v = 0; v < n; ++v) {
+    const auto neighbors = graph.neighbors(v);
+    CHECK(is_sorted(neighbors.begin(), neighbors.end()));
+    CHECK(adjacent_find(neighbors.begin(), neighbors.end()) ==
+          neighbors.end());
+    for (auto u : neighbors) {
+      const auto back = graph.neighbors(u);
+      CHECK(binary_search(back.begin(), back.end(), v));
+    }
+  }
+
+  SUBCASE("Gabriel and relative neighborhood graph") {
+    const auto gabriel = delaunay::gabriel_graph(points, graph);
+    const auto rng_graph = delaunay::relative_neighborhood_graph(points, graph);
+    for (size_t v = 0; v < n; ++v) {
+      for (auto u : graph.neighbors(v)) {
+        bool is_gabriel = true;
+        bool is_relative = true;
+        for (size_t r = 0; r < n; ++r) {
+          if ((r == u) || (r == v)) continue;
+          is_gabriel &= dot(points[u] - points[r], points[v] - points[r]) >= 0;
+          is_relative &= max(distance(u, r), distance(v, r)) >= distance(u, v);
+        }
+        const auto g = gabriel.neighbors(v);
+        CHECK(binary_search(g.begin(), g.end(), u) == is_gabriel);
+        const auto r = rng_graph.neighbors(v);
+        CHECK(binary_search(r.begin(), r.end(), u) == is_relative);
+      }
+    }
+  }
+
+  SUBCASE("k-nearest neighbor graph") {
+    const size_t k = 8;
+    const auto nearest = delaunay::nearest_neighbor_graph(points, graph, k);
+    vector<size_t> order(n);
+    for (size_t v = 0; v < n; ++v) {
+      REQUIRE(nearest.degree(v) == k);
+      for (size_t u = 0; u < n; ++u) order[u] = u;
+      sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return distance(v, a) < distance(v, b);
+      });
+      // The first entry is the point itself.
+      const auto neighbors = nearest.neighbors(v);
+      CHECK(equal(neighbors.begin(), neighbors.end(), order.begin() + 1));
+    }
+  }
+
+  SUBCASE("Euclidean minimum spanning tree") {
+    const auto tree = delaunay::minimum_spanning_tree(points, graph);
+    CHECK(tree.edge_count() == 2 * (n - 1));
+    double length = 0;
+    for (size_t v = 0; v < n; ++v)
+      for (auto u : tree.neighbors(v)) length += sqrt(distance(u, v));
+    length /= 2;
+
+    // Prim's algorithm on the complete graph.
+    vector<float> key(n, numeric_limits<float>::infinity());
+    vector<bool> done(n, false);
+    key[0] = 0;
+    double expected = 0;
+    for (size_t i = 0; i < n; ++i) {
+      size_t v = n;
+      for (size_t u = 0; u < n; ++u)
+        if (!done[u] && ((v == n) || (key[u] < key[v]))) v = u;
+      done[v] = true;
+      expected += sqrt(key[v]);
+      for (size_t u = 0; u < n; ++u)
+        if (!done[u]) key[u] = min(key[u], distance(u, v));
+    }
+    CHECK(length == doctest::Approx(expected));
+  }
+}
+
+TEST_CASE("Nearest neighbor rows of isolated vertices are empty.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+
+  std::vector<point> points(100);
+  for (auto& p : points) p = point{dist(rng), dist(rng)};
+  // The ghost engine skips the duplicate, which stays isolated.
+  points.push_back(points[0]);
+  const auto n = points.size();
+  const auto triangles = delaunay::bowyer_watson::ghost::triangulation(points);
+  const auto graph = delaunay::delaunay_graph<3>(triangles, n);
+  REQUIRE(graph.degree(n - 1) == 0);
+
+  const size_t k = 5;
+  const auto nearest = delaunay::nearest_neighbor_graph(points, graph, k);
+  REQUIRE(nearest.vertex_count() == n);
+  CHECK(nearest.degree(n - 1) == 0);
+  CHECK(nearest.edge_count() == (n - 1) * k);
+  for (size_t v = 0; v + 1 < n; ++v) {
+    CHECK(nearest.degree(v) == k);
+    for (auto u : nearest.neighbors(v)) {
+      CHECK(u != v);
+      CHECK(u != n - 1);
+    }
+  }
+}
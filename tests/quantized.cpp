@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/quantized.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::connectivity;
+using delaunay::int32x2;
+
+namespace {
+
+// Check the empty circumcircle property by the exact predicate
+// and that the triangles cover the convex hull of unique points.
+void check_exact_delaunay(
+    const vector<int32x2>& points, size_t unique,
+    const vector<delaunay::bowyer_watson::triangle>& elements,
+    const connectivity<3>& adjacency) {
+  size_t boundary_edges = 0;
+  for (const auto& n : adjacency.neighbors)
+    for (auto j : n) boundary_edges += (j == adjacency.none);
+  CHECK(elements.size() == 2 * unique - 2 - boundary_edges);
+
+  for (const auto& t : elements) {
+    CHECK(counterclockwise(points[t[0]], points[t[1]], points[t[2]]));
+    for (const auto& p : points)
+      CHECK(!circumcircle_intersection(points[t[0]], points[t[1]],
+                                       points[t[2]], p));
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Integer predicates are exact for 30-bit coordinates.") {
+  const int32_t m = (int32_t{1} << 30) - 1;
+  // Nearly collinear points far away from the origin.
+  CHECK(clockwise(int32x2{0, 0}, int32x2{m, m - 1}, int32x2{m - 1, m - 2}));
+  CHECK(counterclockwise(int32x2{0, 0}, int32x2{m - 1, m - 2},
+                         int32x2{m, m - 1}));
+  CHECK(!counterclockwise(int32x2{0, 0}, int32x2{m, m}, int32x2{m - 1, m - 1}));
+  // Cocircular points are not inside of each others circumcircle.
+  CHECK(!circumcircle_intersection(int32x2{0, 0}, int32x2{m, 0},
+                                   int32x2{m, m}, int32x2{0, m}));
+  CHECK(circumcircle_intersection(int32x2{0, 0}, int32x2{m, 0},
+                                  int32x2{m, m}, int32x2{1, m - 1}));
+  CHECK(!circumcircle_intersection(int32x2{0, 0}, int32x2{m, 0},
+                                   int32x2{m, m}, int32x2{0, m + 1}));
+}
+
+TEST_CASE("A grid of cocircular points is triangulated exactly.") {
+  vector<int32x2> points{};
+  const int32_t n = 20;
+  const int32_t step = (int32_t{1} << 25) + 1;
+  for (int32_t i = 0; i < n; ++i)
+    for (int32_t j = 0; j < n; ++j) points.push_back({i * step, j * step});
+  // Duplicates are ignored.
+  points.push_back(points[3]);
+
+  connectivity<3> adjacency{};
+  const auto elements =
+      delaunay::bowyer_watson::ghost::triangulation(points, &adjacency);
+  CHECK(elements.size() == 2 * (n - 1) * (n - 1));
+  check_exact_delaunay(points, n * n, elements, adjacency);
+}
+
+TEST_CASE("Floating-point input is quantized to the exact grid.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{-1, 1};
+  const auto random = [&] { return dist(rng); };
+
+  vector<delaunay::float32x2> points(500);
+  for (auto& p : points) p = {random(), 1e-3f * random()};
+
+  const auto quantized = delaunay::quantize(points);
+  REQUIRE(quantized.points.size() == points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto p = quantized.position(quantized.points[i]);
+    CHECK(abs(p[0] - points[i][0]) <= 1 / quantized.scale);
+    CHECK(abs(p[1] - points[i][1]) <= 1 / quantized.scale);
+  }
+
+  connectivity<3> adjacency{};
+  const auto elements =
+      delaunay::bowyer_watson::quantized::triangulation(points, &adjacency);
+  check_exact_delaunay(quantized.points, points.size(), elements, adjacency);
+}
@@ -0,0 +1,127 @@
+#include <random>
+#include <stdexcept>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/regular.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::connectivity;
+using delaunay::regular::power_test;
+
+TEST_CASE("Weighted points are triangulated regularly in 2D.") {
+  using delaunay::regular::point;
+
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+  uniform_real_distribution<float> weight{0, 0.004f};
+
+  vector<point> points(400);
+  for (auto& p : points) p = point{dist(rng), dist(rng)};
+  vector<float> weights(points.size());
+  for (auto& w : weights) w = weight(rng);
+  // A heavier duplicate hides the first point. Its weight exceeds all other
+  // weights. So its power distance to itself is smaller than to any other
+  // point and it cannot be redundant.
+  points.push_back(points[0]);
+  weights.push_back(0.005f);
+
+  connectivity<3> adjacency{};
+  const auto triangles =
+      delaunay::regular::triangulation(points, weights, &adjacency);
+
+  vector<char> vertex(points.size(), false);
+  for (const auto& t : triangles)
+    for (auto v : t) vertex[v] = true;
+  size_t vertices = 0;
+  for (auto v : vertex) vertices += v;
+  CHECK(!vertex[0]);
+  CHECK(vertex.back());
+  // Some points are hidden by the weights of their neighbors.
+  CHECK(vertices < points.size() - 1);
+
+  size_t boundary_edges = 0;
+  for (const auto& n : adjacency.neighbors)
+    for (auto j : n) boundary_edges += (j == adjacency.none);
+  CHECK(triangles.size() == 2 * vertices - 2 - boundary_edges);
+
+  for (const auto& t : triangles) {
+    const auto& a = points[t[0]];
+    const auto& b = points[t[1]];
+    const auto& c = points[t[2]];
+    CHECK(counterclockwise(a, b, c));
+    // No lifted point lies below the lifted triangle. Redundant points
+    // inside the triangle do not lie below it either.
+    for (size_t i = 0; i < points.size(); ++i) {
+      if ((i == t[0]) || (i == t[1]) || (i == t[2])) continue;
+      CHECK(power_test(a, weights[t[0]], b, weights[t[1]], c, weights[t[2]],
+                       points[i], weights[i]) < 1e-9);
+    }
+  }
+
+  SUBCASE("Zero weights yield the Delaunay triangulation.") {
+    points.pop_back();
+    weights.assign(points.size(), 0);
+    const auto delaunay_triangles =
+        delaunay::regular::triangulation(points, weights);
+    const auto expected = delaunay::bowyer_watson::ghost::triangulation(points);
+    CHECK(delaunay_triangles.size() == expected.size());
+  }
+
+  SUBCASE("Every point needs a weight.") {
+    weights.pop_back();
+    CHECK_THROWS_AS(delaunay::regular::triangulation(points, weights),
+                    invalid_argument);
+  }
+}
+
+TEST_CASE("Weighted points are triangulated regularly in 3D.") {
+  using delaunay::regular::point3;
+
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+  uniform_real_distribution<float> weight{0, 0.03f};
+
+  vector<point3> points(200);
+  for (auto& p : points) p = point3{dist(rng), dist(rng), dist(rng)};
+  vector<float> weights(points.size());
+  for (auto& w : weights) w = weight(rng);
+
+  connectivity<4> adjacency{};
+  const auto tetrahedra =
+      delaunay::regular::triangulation(points, weights, &adjacency);
+  CHECK(adjacency.neighbors.size() == tetrahedra.size());
+
+  vector<char> vertex(points.size(), false);
+  for (const auto& t : tetrahedra)
+    for (auto v : t) vertex[v] = true;
+  size_t vertices = 0;
+  for (auto v : vertex) vertices += v;
+  CHECK(vertices < points.size());
+
+  for (const auto& t : tetrahedra) {
+    const auto& a = points[t[0]];
+    const auto& b = points[t[1]];
+    const auto& c = points[t[2]];
+    const auto& d = points[t[3]];
+    CHECK(delaunay::experimental_3d::ghost::orientation(a, b, c, d) > 0);
+    // No lifted point lies below the lifted tetrahedron.
+    for (size_t i = 0; i < points.size(); ++i) {
+      if ((i == t[0]) || (i == t[1]) || (i == t[2]) || (i == t[3])) continue;
+      CHECK(power_test(a, weights[t[0]], b, weights[t[1]], c, weights[t[2]],
+                       d, weights[t[3]], points[i], weights[i]) < 1e-9);
+    }
+  }
+
+  SUBCASE("Zero weights yield the Delaunay triangulation.") {
+    weights.assign(points.size(), 0);
+    const auto delaunay_tetrahedra =
+        delaunay::regular::triangulation(points, weights);
+    const auto expected =
+        delaunay::experimental_3d::ghost::triangulation(points);
+    CHECK(!expected.empty());
+    CHECK(delaunay_tetrahedra.size() == expected.size());
+  }
+}
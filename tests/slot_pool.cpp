@@ -0,0 +1,80 @@
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/delaunay.hpp>
+#include <lyrahgames/delaunay/memory.hpp>
+#include <lyrahgames/delaunay/slot_pool.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::memory_usage;
+using delaunay::tracking_allocator;
+
+TEST_CASE("Slot pools reuse erased slots and detect stale handles.") {
+  delaunay::slot_pool<int> pool{};
+  const auto a = pool.insert(1);
+  const auto b = pool.insert(2);
+  const auto c = pool.insert(3);
+  CHECK(pool.size() == 3);
+  CHECK(pool[b] == 2);
+
+  pool.erase(b);
+  CHECK(pool.size() == 2);
+  CHECK(!pool.alive(b.slot));
+  CHECK(!pool.contains(b));
+  CHECK(pool.contains(a));
+  CHECK(pool.contains(c));
+
+  // The tombstone is reused by the next insertion with a new generation.
+  const auto d = pool.insert(4);
+  CHECK(d.slot == b.slot);
+  CHECK(d.generation != b.generation);
+  CHECK(pool.contains(d));
+  CHECK(!pool.contains(b));
+  CHECK(pool.slot_count() == 3);
+
+  int sum = 0;
+  for (size_t i = 0; i < pool.slot_count(); ++i)
+    if (pool.alive(i)) sum += pool[i];
+  CHECK(sum == 1 + 3 + 4);
+
+  // Stale handles neither erase the new occupant nor free the slot again.
+  pool.erase(b);
+  CHECK(pool.size() == 3);
+  CHECK(pool.contains(d));
+  CHECK(pool[d] == 4);
+  pool.erase(c);
+  pool.erase(c);
+  CHECK(pool.size() == 2);
+  const auto e = pool.insert(5);
+  const auto f = pool.insert(6);
+  CHECK(e.slot == c.slot);
+  CHECK(f.slot != e.slot);
+  CHECK(pool.size() == 4);
+  CHECK(pool.slot_count() == 4);
+}
+
+TEST_CASE("Legacy engines do not allocate for every simplex.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{0, 1};
+  vector<delaunay::point> points(2000);
+  for (auto& p : points) p = {dist(rng), dist(rng)};
+
+  memory_usage() = {};
+  {
+    const auto triangles =
+        delaunay::experimental::triangulation<tracking_allocator>(points);
+    CHECK(triangles.size() > points.size());
+    // Only the pool, the polytope, and the result grow geometrically.
+    CHECK(memory_usage().allocations < 100);
+  }
+  memory_usage() = {};
+  {
+    const auto triangles =
+        delaunay::triangulation<tracking_allocator>(points);
+    CHECK(triangles.size() > points.size());
+    CHECK(memory_usage().allocations < 100);
+  }
+}
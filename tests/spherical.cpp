@@ -0,0 +1,84 @@
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/spherical.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::connectivity;
+using delaunay::spherical::point;
+
+namespace {
+
+// Checks that the triangles cover the sphere with every point as vertex
+// and that no point lies beyond the plane of a triangle.
+void check_triangulation(const vector<point>& points,
+                         const vector<delaunay::spherical::triangle>& triangles,
+                         size_t vertices) {
+  CHECK(triangles.size() == 2 * vertices - 4);
+  vector<char> vertex(points.size(), false);
+  for (const auto& t : triangles) {
+    for (auto v : t) vertex[v] = true;
+    for (const auto& p : points) {
+      // Roundoff errors remain for the vertices of the triangle.
+      const auto o = delaunay::convex_hull::detail::orientation(
+          points[t[0]], points[t[1]], points[t[2]], p);
+      CHECK(o < 1e-12);
+    }
+  }
+  size_t count = 0;
+  for (auto v : vertex) count += v;
+  CHECK(count == vertices);
+}
+
+}  // namespace
+
+TEST_CASE("Points on the sphere are triangulated by their convex hull.") {
+  mt19937 rng{random_device{}()};
+  normal_distribution<double> dist{};
+
+  vector<point> points(2000);
+  for (auto& p : points) p = point{dist(rng), dist(rng), dist(rng)};
+
+  connectivity<3> adjacency{};
+  auto triangles = delaunay::spherical::triangulation(points, &adjacency);
+  // The points are projected to the sphere.
+  for (auto& p : points) {
+    const auto r = sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+    for (auto& x : p) x /= r;
+  }
+  check_triangulation(points, triangles, points.size());
+  CHECK(adjacency.neighbors.size() == triangles.size());
+
+  SUBCASE("Points with the same direction are skipped.") {
+    points.push_back({2 * points[0][0], 2 * points[0][1], 2 * points[0][2]});
+    triangles = delaunay::spherical::triangulation(points);
+    points.back() = points[0];
+    check_triangulation(points, triangles, points.size() - 1);
+  }
+
+  SUBCASE("Points need a direction.") {
+    points.push_back({});
+    CHECK_THROWS_AS(delaunay::spherical::triangulation(points),
+                    invalid_argument);
+  }
+}
+
+TEST_CASE("Points of a longitude-latitude grid are triangulated.") {
+  // Points on the same circle of latitude are coplanar.
+  constexpr double pi = 3.14159265358979323846;
+  vector<point> points{};
+  for (int i = 0; i < 72; ++i)
+    for (int j = -17; j <= 17; ++j)
+      points.push_back(
+          delaunay::spherical::direction(i * pi / 36, j * pi / 36));
+  points.push_back(delaunay::spherical::direction(0, pi / 2));
+  points.push_back(delaunay::spherical::direction(0, -pi / 2));
+
+  const auto triangles = delaunay::spherical::triangulation(points);
+  check_triangulation(points, triangles, points.size());
+}
@@ -0,0 +1,68 @@
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/bowyer_watson.hpp>
+#include <lyrahgames/delaunay/guibas_stolfi.hpp>
+#include <lyrahgames/delaunay/statistics.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::float32x2;
+
+TEST_CASE("Engines report their construction statistics.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{-1, 1};
+  const auto random = [&] { return dist(rng); };
+
+  const size_t n = 1000;
+  vector<float32x2> points(n);
+  for (auto& p : points) p = float32x2{random(), random()};
+
+  SUBCASE("Bowyer-Watson") {
+    delaunay::statistics statistics{};
+    const auto elements =
+        delaunay::bowyer_watson::triangulation(points, nullptr, statistics);
+    CHECK(statistics.insertions == n);
+    CHECK(statistics.removed_elements.count == n);
+    // Every insertion into the super triangle adds two triangles.
+    CHECK(statistics.created_elements.sum - statistics.removed_elements.sum ==
+          2 * n);
+    CHECK(statistics.removed_elements.bins[0] == 0);
+    CHECK(statistics.incircle_tests > n);
+  }
+
+  SUBCASE("Ghost vertex") {
+    auto vertices = points;
+    vertices.push_back(points[0]);
+    delaunay::statistics statistics{};
+    const auto elements =
+        delaunay::bowyer_watson::ghost::triangulation(vertices, nullptr,
+                                                      statistics);
+    // The three seed points are not counted and the duplicate is skipped.
+    CHECK(statistics.insertions == n - 3);
+    CHECK(statistics.duplicates == 1);
+    CHECK(statistics.removed_elements.count == n - 3);
+  }
+
+  SUBCASE("Quad-edge") {
+    auto vertices = points;
+    vertices.push_back(points[0]);
+    vertices.push_back({-10, -10});
+    vertices.push_back({10, -10});
+    vertices.push_back({0, 20});
+    delaunay::guibas_stolfi::edge_algebra diagram{};
+    diagram.edges.reserve(3 * vertices.size());
+    diagram.set_super_triangle(&vertices[n + 1], &vertices[n + 2],
+                               &vertices[n + 3]);
+    delaunay::statistics statistics{};
+    for (size_t i = 0; i <= n; ++i) diagram.add(&vertices[i], statistics);
+    CHECK(statistics.insertions == n);
+    CHECK(statistics.duplicates == 1);
+    CHECK(statistics.walk_lengths.count == n + 1);
+    CHECK(statistics.flips > 0);
+    CHECK(statistics.incircle_tests >= statistics.flips);
+    CHECK(statistics.orientation_tests >= statistics.walk_lengths.sum);
+  }
+}
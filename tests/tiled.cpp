@@ -0,0 +1,40 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/delaunay/tiled.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using delaunay::tiled::point;
+
+TEST_CASE("Tiles are triangulated independently and stitched together.") {
+  mt19937 rng{random_device{}()};
+  uniform_real_distribution<float> dist{-1, 1};
+
+  vector<point> points(5000);
+  for (auto& p : points) p = point{dist(rng), dist(rng)};
+
+  // Rotate every triangle to start at its smallest index.
+  const auto normalized = [](auto triangles) {
+    for (auto& t : triangles)
+      rotate(t.begin(), min_element(t.begin(), t.end()), t.end());
+    sort(triangles.begin(), triangles.end());
+    return triangles;
+  };
+
+  // A single tile is the plain quad-edge triangulation.
+  const auto expected = normalized(
+      delaunay::tiled::triangulation(points, nullptr, points.size()));
+  REQUIRE(!expected.empty());
+
+  for (size_t tile_size : {64, 500, 2048}) {
+    delaunay::connectivity<3> adjacency{};
+    const auto triangles =
+        delaunay::tiled::triangulation(points, &adjacency, tile_size);
+    CHECK(adjacency.neighbors.size() == triangles.size());
+    CHECK(normalized(triangles) == expected);
+  }
+}